@@ -1,10 +1,43 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
-#include <initializer_list>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// the os calls are only for print and the memory mapped file builtins
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #define __panic(message)                                                                                               \
+    Liam::flush_print_buffer();                                                                                        \
     std::cout << "PANIC " << __FILE__ << " (" << __LINE__ << ") :: " << message << "\n";                               \
     exit(1);
 
@@ -18,44 +51,185 @@ typedef int32_t i32;
 // typedef uint32_t u32;
 typedef float f32;
 
-// typedef uint64_t    u64;
-typedef int64_t     i64;
-typedef long double f64;
+// typedef uint64_t u64;
+typedef int64_t i64;
+typedef double  f64;
 
+// liamc defines the profile before including this, release drops asserts
+#if defined(LIAM_PROFILE_RELEASE)
+#define __ASSERT(expr)
+#else
 #define __ASSERT(expr)                                                                                                 \
     if (!(expr)) {                                                                                                     \
+        Liam::flush_print_buffer();                                                                                    \
         std::cerr << "ASSERT :: " << __FILE_NAME__ << " :: line " << __LINE__ << "\n  --> (" << std::string(#expr)     \
                   << ")\n";                                                                                            \
         exit(1);                                                                                                       \
     }
+#endif
+
+// goes before loops tagged #simd, the iterations are said not to depend on each
+// other so the compiler vectorizes without checking the arrays do not overlap
+#if defined(__clang__)
+#define __SIMD_LOOP _Pragma("clang loop vectorize(assume_safety)")
+#else
+#define __SIMD_LOOP _Pragma("GCC ivdep")
+#endif
 
 namespace Liam {
-constexpr u8 make_u8(u8 n) {
-    return n;
-}
+// print writes into a buffer per thread instead of going through std::cout, it
+// is written to stdout with one write call when it is full, before a for par
+// starts, when a worker finishes its part of one, before a panic and when the
+// thread exits. When it is full only the whole lines are written and the rest
+// is kept, so lines from different threads are not split up unless one line is
+// longer than the whole buffer
+struct PrintBuffer {
+    static constexpr i64 CAPACITY = 1 << 16;
 
-constexpr i8 make_i8(i8 n) {
-    return n;
-}
+    char data[CAPACITY];
+    i64  size = 0;
+
+    ~PrintBuffer() {
+        flush();
+    }
+
+    void flush() {
+        write_out(this->size);
+        this->size = 0;
+    }
+
+    // writes up to the last new line and moves what is after it to the start
+    void flush_lines() {
+        i64 end = this->size;
+        while (end > 0 && this->data[end - 1] != '\n') {
+            end--;
+        }
+
+        // one line filled all of it
+        if (end == 0) {
+            flush();
+            return;
+        }
+
+        write_out(end);
+        std::memmove(&this->data[0], &this->data[end], this->size - end);
+        this->size -= end;
+    }
+
+    void write_out(i64 count) {
+#if defined(_WIN32)
+        // there is no write on windows, fwrite with the stdio buffer flushed straight
+        // after does the same as one write call
+        fwrite(this->data, 1, count, stdout);
+        fflush(stdout);
+#else
+        i64 written = 0;
+        while (written < count) {
+            ssize_t result = ::write(STDOUT_FILENO, &this->data[written], count - written);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+
+            // stdout is gone so there is nowhere to report it
+            if (result < 0) {
+                break;
+            }
+            written += result;
+        }
+#endif
+    }
+
+    // somewhere to write up to count bytes, size has to be moved past them after
+    char *reserve(i64 count) {
+        if (this->size + count > CAPACITY) {
+            flush_lines();
+        }
+
+        if (this->size + count > CAPACITY) {
+            flush();
+        }
+
+        return &this->data[this->size];
+    }
+
+    void append(char c) {
+        *reserve(1) = c;
+        this->size++;
+    }
+
+    void append(const char *bytes, i64 count) {
+        while (count > 0) {
+            if (this->size == CAPACITY) {
+                flush_lines();
+            }
+
+            i64 part = std::min(count, CAPACITY - this->size);
+            std::memcpy(&this->data[this->size], bytes, part);
+            this->size += part;
+            bytes += part;
+            count -= part;
+        }
+    }
+};
+
+inline thread_local PrintBuffer print_buffer;
 
-constexpr i16 make_i16(i16 n) {
-    return n;
+inline void flush_print_buffer() {
+    print_buffer.flush();
 }
 
-constexpr i32 make_i32(i32 n) {
-    return n;
+// formats value the same as std::cout did, numbers use to_chars and floats keep
+// the 6 significant digits cout uses. i8 and u8 are written as characters. The
+// liam containers have a write_to which calls this for each value
+template <typename T> void write_value(PrintBuffer &out, const T &value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        out.append(value ? '1' : '0');
+    } else if constexpr (std::is_integral_v<T> && sizeof(T) == 1) {
+        out.append((char)value);
+    } else if constexpr (std::is_integral_v<T>) {
+        char *first = out.reserve(24);
+        out.size    = std::to_chars(first, first + 24, value).ptr - out.data;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        char *first = out.reserve(32);
+        out.size    = std::to_chars(first, first + 32, value, std::chars_format::general, 6).ptr - out.data;
+    } else if constexpr (std::is_pointer_v<T>) {
+        if (value == NULL) {
+            out.append('0');
+            return;
+        }
+
+        char *first = out.reserve(24);
+        first[0]    = '0';
+        first[1]    = 'x';
+        out.size    = std::to_chars(first + 2, first + 24, (uintptr_t)value, 16).ptr - out.data;
+    } else {
+        value.write_to(out);
+    }
 }
 
-constexpr f32 make_f32(f32 n) {
-    return n;
+// print x --> Liam::print(x)
+template <typename T> void print(const T &value) {
+    PrintBuffer &out = print_buffer;
+    write_value(out, value);
+    out.append('\n');
 }
 
-constexpr i64 make_i64(i64 n) {
-    return n;
+// file and line are of the liam code not the generated c++
+[[noreturn]] inline void bounds_panic(const char *file, i64 line, i64 index, i64 size) {
+    flush_print_buffer();
+    std::cout << "PANIC " << file << " (" << line << ") :: index " << index << " is out of bounds for size " << size
+              << "\n";
+    exit(1);
 }
 
-constexpr f64 make_f64(f64 n) {
-    return n;
+// a[{start:end}] has to be inside a, the checked slice fns call this in debug builds
+inline void check_slice_bounds(const char *file, i64 line, i64 start, i64 end, i64 size) {
+    if (start < 0 || end < start || end > size) {
+        flush_print_buffer();
+        std::cout << "PANIC " << file << " (" << line << ") :: slice {" << start << ":" << end
+                  << "} is out of bounds for size " << size << "\n";
+        exit(1);
+    }
 }
 
 template <typename T> struct Slice {
@@ -67,75 +241,175 @@ template <typename T> struct Slice {
         this->size    = size;
     }
 
-    Slice<T> slice_full() {
+    Slice<T> slice_full() const {
         return Slice<T>(&this->pointer[0], this->size);
     }
 
-    Slice<T> slice_with_start_and_end(i64 start, i64 end) {
+    Slice<T> slice_with_start_and_end(i64 start, i64 end) const {
         return Slice<T>(&this->pointer[start], end - start);
     }
 
-    Slice<T> slice_with_start(i64 start) {
+    Slice<T> slice_with_start(i64 start) const {
         return Slice<T>(&this->pointer[start], this->size - start);
     }
 
-    Slice<T> slice_with_end(i64 end) {
+    Slice<T> slice_with_end(i64 end) const {
         return Slice<T>(&this->pointer[0], end);
     }
 
+    // used instead of the slice fns in debug builds
+    Slice<T> checked_slice_with_start_and_end(i64 start, i64 end, const char *file, i64 line) const {
+        check_slice_bounds(file, line, start, end, this->size);
+        return slice_with_start_and_end(start, end);
+    }
+
+    Slice<T> checked_slice_with_start(i64 start, const char *file, i64 line) const {
+        check_slice_bounds(file, line, start, this->size, this->size);
+        return slice_with_start(start);
+    }
+
+    Slice<T> checked_slice_with_end(i64 end, const char *file, i64 line) const {
+        check_slice_bounds(file, line, 0, end, this->size);
+        return slice_with_end(end);
+    }
+
     // we need to use T& to make Slice[n] assignable, check array for more
-    // detailed explaination
-    T &operator[](i64 index) {
-        // TODO we should have bounds checking in this for debug builds
+    // detailed explaination. A slice is only a view so being const does
+    // not make what it points to const
+    T &operator[](i64 index) const {
         return this->pointer[index];
     }
 
-    // define a << overload for std::cout
-    friend std::ostream &operator<<(std::ostream &os, const Slice<T> &obj) {
-        os << "[";
-        for (i64 i = 0; i < obj.size; i++) {
-            os << obj.pointer[i];
-            if (i != obj.size - 1) {
-                os << ", ";
+    // used instead of [] in debug builds
+    T &checked_index(i64 index, const char *file, i64 line) const {
+        if (index < 0 || index >= this->size) {
+            bounds_panic(file, line, index, this->size);
+        }
+
+        return this->pointer[index];
+    }
+
+    // used by print
+    void write_to(PrintBuffer &out) const {
+        out.append('[');
+        for (i64 i = 0; i < this->size; i++) {
+            write_value(out, this->pointer[i]);
+            if (i != this->size - 1) {
+                out.append(", ", 2);
             }
         }
-        os << "]";
-        return os;
+        out.append(']');
     }
 };
 
-template <i64 N, typename T> struct StaticArray {
-    T   array[N];
+// a slice param tagged #noalias, the pointer is restrict so the compiler knows
+// nothing else in the fn writes to what it points to. It is made from and turns
+// back into a Slice whenever it is passed on so only the fn it is a param of sees it
+template <typename T> struct NoAliasSlice {
+    T *__restrict pointer;
     i64 size;
 
-    StaticArray() {
-        this->size = N;
+    NoAliasSlice(Slice<T> slice) {
+        this->pointer = slice.pointer;
+        this->size    = slice.size;
+    }
+
+    operator Slice<T>() const {
+        return Slice<T>(this->pointer, this->size);
+    }
+
+    Slice<T> slice_full() const {
+        return Slice<T>(this->pointer, this->size);
+    }
+
+    Slice<T> slice_with_start_and_end(i64 start, i64 end) const {
+        return Slice<T>(&this->pointer[start], end - start);
+    }
+
+    Slice<T> slice_with_start(i64 start) const {
+        return Slice<T>(&this->pointer[start], this->size - start);
+    }
+
+    Slice<T> slice_with_end(i64 end) const {
+        return Slice<T>(this->pointer, end);
+    }
+
+    // used instead of the slice fns in debug builds
+    Slice<T> checked_slice_with_start_and_end(i64 start, i64 end, const char *file, i64 line) const {
+        check_slice_bounds(file, line, start, end, this->size);
+        return slice_with_start_and_end(start, end);
+    }
+
+    Slice<T> checked_slice_with_start(i64 start, const char *file, i64 line) const {
+        check_slice_bounds(file, line, start, this->size, this->size);
+        return slice_with_start(start);
+    }
+
+    Slice<T> checked_slice_with_end(i64 end, const char *file, i64 line) const {
+        check_slice_bounds(file, line, 0, end, this->size);
+        return slice_with_end(end);
     }
 
-    explicit StaticArray(std::initializer_list<T> list) {
-        this->size = N;
+    T &operator[](i64 index) const {
+        return this->pointer[index];
+    }
 
-        i64 index  = 0;
-        for (auto iter = list.begin(); iter != list.end(); iter++) {
-            this->array[index] = *iter;
-            index++;
+    T &checked_index(i64 index, const char *file, i64 line) const {
+        if (index < 0 || index >= this->size) {
+            bounds_panic(file, line, index, this->size);
         }
+
+        return this->pointer[index];
+    }
+
+    void write_to(PrintBuffer &out) const {
+        Slice<T>(this->pointer, this->size).write_to(out);
+    }
+};
+
+// this is kept as an aggregate so array literals can be brace initialised
+// without copying through an initializer_list and can be constant expressions.
+// The size is part of the type so it takes up no space, [4][2]u8 is 8 bytes
+template <i64 N, typename T> struct StaticArray {
+    static constexpr i64 size = N;
+
+    T array[N];
+
+    // these are const so they work on arrays in structs passed by const reference, the
+    // compiler only passes by reference when nothing is written through these slices.
+    // Embedded files are the only const arrays in read only memory, liamc only lets them
+    // be sliced where it can tell nothing writes through the slice, so the const_cast is
+    // never written through on them
+    Slice<T> slice_full() const {
+        return Slice<T>(const_cast<T *>(&this->array[0]), this->size);
+    }
+
+    Slice<T> slice_with_start_and_end(i64 start, i64 end) const {
+        return Slice<T>(const_cast<T *>(&this->array[start]), end - start);
+    }
+
+    Slice<T> slice_with_start(i64 start) const {
+        return Slice<T>(const_cast<T *>(&this->array[start]), this->size - start);
     }
 
-    Slice<T> slice_full() {
-        return Slice<T>(&this->array[0], this->size);
+    Slice<T> slice_with_end(i64 end) const {
+        return Slice<T>(const_cast<T *>(&this->array[0]), end);
     }
 
-    Slice<T> slice_with_start_and_end(i64 start, i64 end) {
-        return Slice<T>(&this->array[start], end - start);
+    // used instead of the slice fns in debug builds
+    Slice<T> checked_slice_with_start_and_end(i64 start, i64 end, const char *file, i64 line) const {
+        check_slice_bounds(file, line, start, end, this->size);
+        return slice_with_start_and_end(start, end);
     }
 
-    Slice<T> slice_with_start(i64 start) {
-        return Slice<T>(&this->array[start], this->size - start);
+    Slice<T> checked_slice_with_start(i64 start, const char *file, i64 line) const {
+        check_slice_bounds(file, line, start, this->size, this->size);
+        return slice_with_start(start);
     }
 
-    Slice<T> slice_with_end(i64 end) {
-        return Slice<T>(&this->array[0], end);
+    Slice<T> checked_slice_with_end(i64 end, const char *file, i64 line) const {
+        check_slice_bounds(file, line, 0, end, this->size);
+        return slice_with_end(end);
     }
 
     // we need to use T& to make Array[n] assignable i.e. we need a
@@ -144,20 +418,1269 @@ template <i64 N, typename T> struct StaticArray {
     // generated cpp code as the compiler doesn't know about
     // l or r values
     T &operator[](i64 index) {
-        // TODO we should have bounds checking in this for debug builds
         return this->array[index];
     }
 
-    friend std::ostream &operator<<(std::ostream &os, const StaticArray<N, T> &obj) {
-        os << "[";
-        for (i64 i = 0; i < obj.size; i++) {
-            os << obj.array[i];
-            if (i != obj.size - 1) {
-                os << ", ";
+    const T &operator[](i64 index) const {
+        return this->array[index];
+    }
+
+    // used instead of [] in debug builds
+    T &checked_index(i64 index, const char *file, i64 line) {
+        if (index < 0 || index >= N) {
+            bounds_panic(file, line, index, N);
+        }
+
+        return this->array[index];
+    }
+
+    const T &checked_index(i64 index, const char *file, i64 line) const {
+        if (index < 0 || index >= N) {
+            bounds_panic(file, line, index, N);
+        }
+
+        return this->array[index];
+    }
+
+    void write_to(PrintBuffer &out) const {
+        out.append('[');
+        for (i64 i = 0; i < N; i++) {
+            write_value(out, this->array[i]);
+            if (i != N - 1) {
+                out.append(", ", 2);
+            }
+        }
+        out.append(']');
+    }
+};
+
+// gets size bytes aligned to alignment straight from the system, the arenas and
+// pools use this for their chunks and give the memory back with std::free
+inline void *allocate_chunk(i64 size, i64 alignment) {
+    alignment = std::max(alignment, (i64)alignof(std::max_align_t));
+    size      = (size + alignment - 1) / alignment * alignment;
+
+    void *memory = std::aligned_alloc(alignment, size);
+    if (memory == NULL) {
+        __panic("out of memory");
+    }
+
+    return memory;
+}
+
+// bump allocator, allocations are taken from the end of the current chunk and
+// a new chunk twice the size of the last is added once it is full. Reset keeps
+// every chunk so it is O(1) and once the chunks are big enough for the work
+// between resets nothing else is allocated from the system. Nothing allocated
+// in it is destructed, all liam types are trivially destructible
+struct Arena {
+    struct Chunk {
+        Chunk *next;
+        i64    size; // bytes after the chunk header
+        i64    used;
+    };
+
+    static constexpr i64 FIRST_CHUNK_SIZE = 64 * 1024;
+    static constexpr i64 MAX_CHUNK_SIZE   = 64 * 1024 * 1024;
+
+    Chunk *first;
+    Chunk *current;
+    i64    next_chunk_size;
+
+    Arena() {
+        this->first           = NULL;
+        this->current         = NULL;
+        this->next_chunk_size = FIRST_CHUNK_SIZE;
+    }
+
+    // copying would free the chunks twice, liamc only lets arenas be passed by pointer
+    Arena(const Arena &)            = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    ~Arena() {
+        Chunk *chunk = this->first;
+        while (chunk != NULL) {
+            Chunk *next = chunk->next;
+            std::free(chunk);
+            chunk = next;
+        }
+    }
+
+    void *allocate(i64 size, i64 alignment) {
+        while (this->current != NULL) {
+            uintptr_t data  = (uintptr_t)(this->current + 1);
+            uintptr_t start = (data + this->current->used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            if (start + size <= data + this->current->size) {
+                this->current->used = start + size - data;
+                return (void *)start;
+            }
+
+            // chunks kept from before a reset are used before making new ones
+            if (this->current->next == NULL) {
+                break;
+            }
+
+            this->current       = this->current->next;
+            this->current->used = 0;
+        }
+
+        i64    chunk_size = std::max(this->next_chunk_size, size + alignment);
+        Chunk *chunk      = (Chunk *)allocate_chunk(sizeof(Chunk) + chunk_size, alignof(Chunk));
+        chunk->next       = NULL;
+        chunk->size       = chunk_size;
+        chunk->used       = 0;
+
+        if (this->current == NULL) {
+            this->first = chunk;
+        } else {
+            this->current->next = chunk;
+        }
+
+        this->current         = chunk;
+        this->next_chunk_size = std::min(this->next_chunk_size * 2, MAX_CHUNK_SIZE);
+        return allocate(size, alignment);
+    }
+
+    void reset() {
+        this->current = this->first;
+        if (this->current != NULL) {
+            this->current->used = 0;
+        }
+    }
+
+    // bytes allocated since the last reset, including padding for alignment
+    i64 used() const {
+        if (this->current == NULL) {
+            return 0;
+        }
+
+        i64 bytes = 0;
+        for (Chunk *chunk = this->first; chunk != this->current; chunk = chunk->next) {
+            bytes += chunk->size;
+        }
+
+        return bytes + this->current->used;
+    }
+};
+
+// fixed size free list of T, freed slots are reused by the next allocation so
+// lots of values being made and freed never goes back to the system. Slots are
+// taken from chunks that double in size like the arena. Every chunk is freed
+// when the pool is, so values still in it are gone with it
+template <typename T> struct Pool {
+    union Slot {
+        Slot *next; // when on the free list
+        alignas(T) u8 value[sizeof(T)];
+    };
+
+    static constexpr i64 FIRST_CHUNK_SLOTS = 64;
+
+    Slot *chunks;    // the first slot of every chunk links to the next chunk
+    Slot *free_list;
+    i64   next_chunk_slots;
+
+    Pool() {
+        this->chunks           = NULL;
+        this->free_list        = NULL;
+        this->next_chunk_slots = FIRST_CHUNK_SLOTS;
+    }
+
+    Pool(const Pool &)            = delete;
+    Pool &operator=(const Pool &) = delete;
+
+    ~Pool() {
+        Slot *chunk = this->chunks;
+        while (chunk != NULL) {
+            Slot *next = chunk->next;
+            std::free(chunk);
+            chunk = next;
+        }
+    }
+
+    T *allocate() {
+        if (this->free_list == NULL) {
+            Slot *chunk  = (Slot *)allocate_chunk(sizeof(Slot) * (this->next_chunk_slots + 1), alignof(Slot));
+            chunk->next  = this->chunks;
+            this->chunks = chunk;
+
+            // pushed in reverse so slots are given out in address order
+            for (i64 i = this->next_chunk_slots; i > 0; i--) {
+                chunk[i].next   = this->free_list;
+                this->free_list = &chunk[i];
+            }
+
+            this->next_chunk_slots *= 2;
+        }
+
+        Slot *slot      = this->free_list;
+        this->free_list = slot->next;
+        return (T *)slot->value;
+    }
+
+    void free(T *value) {
+        value->~T();
+        Slot *slot      = (Slot *)value;
+        slot->next      = this->free_list;
+        this->free_list = slot;
+    }
+};
+
+// new(arena) T{...} and new(pool) T{...}
+template <typename T> T *allocate_in(Arena &arena, T value) {
+    return new (arena.allocate(sizeof(T), alignof(T))) T(value);
+}
+
+template <typename T> T *allocate_in(Pool<T> &pool, T value) {
+    return new (pool.allocate()) T(value);
+}
+
+// arena_slice(arena, T, count), the values are zeroed the same as a zero literal
+template <typename T> Slice<T> arena_slice(Arena &arena, i64 count) {
+    __ASSERT(count >= 0);
+    T *values = (T *)arena.allocate(sizeof(T) * count, alignof(T));
+    for (i64 i = 0; i < count; i++) {
+        new (&values[i]) T{};
+    }
+
+    return Slice<T>(values, count);
+}
+
+// growable array, [dyn]T in liam. Pushing to a full one doubles its capacity so
+// pushes are amortised O(1). The memory comes from the system unless use_arena
+// is called, then it is taken from the arena and old buffers are left for the
+// arena to get back on reset. Copies copy every value like StaticArray does so a
+// [dyn]T is a value like every other liam type, slicing one gives a view of it
+template <typename T> struct Array {
+    static constexpr i64 FIRST_CAPACITY = 8;
+
+    T     *pointer;
+    i64    size;
+    i64    capacity;
+    Arena *arena; // NULL when using the system allocator
+
+    Array() {
+        this->pointer  = NULL;
+        this->size     = 0;
+        this->capacity = 0;
+        this->arena    = NULL;
+    }
+
+    Array(const Array<T> &other) : Array() {
+        this->arena = other.arena;
+        reserve(other.size);
+        for (i64 i = 0; i < other.size; i++) {
+            new (&this->pointer[i]) T(other.pointer[i]);
+        }
+        this->size = other.size;
+    }
+
+    Array(Array<T> &&other) noexcept {
+        this->pointer  = other.pointer;
+        this->size     = other.size;
+        this->capacity = other.capacity;
+        this->arena    = other.arena;
+        other.pointer  = NULL;
+        other.size     = 0;
+        other.capacity = 0;
+    }
+
+    Array<T> &operator=(const Array<T> &other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size);
+            for (i64 i = 0; i < other.size; i++) {
+                new (&this->pointer[i]) T(other.pointer[i]);
+            }
+            this->size = other.size;
+        }
+
+        return *this;
+    }
+
+    Array<T> &operator=(Array<T> &&other) noexcept {
+        if (this != &other) {
+            this->~Array();
+            new (this) Array<T>(std::move(other));
+        }
+
+        return *this;
+    }
+
+    ~Array() {
+        clear();
+        if (this->arena == NULL) {
+            std::free(this->pointer);
+        }
+    }
+
+    // moves the values into a new buffer from the arena or the system and gives
+    // the old one back if it came from the system
+    void reallocate(i64 new_capacity, Arena *new_arena) {
+        T *new_pointer;
+        if (new_arena != NULL) {
+            new_pointer = (T *)new_arena->allocate(sizeof(T) * new_capacity, alignof(T));
+        } else {
+            new_pointer = (T *)allocate_chunk(sizeof(T) * new_capacity, alignof(T));
+        }
+
+        for (i64 i = 0; i < this->size; i++) {
+            new (&new_pointer[i]) T(std::move(this->pointer[i]));
+            this->pointer[i].~T();
+        }
+
+        if (this->arena == NULL) {
+            std::free(this->pointer);
+        }
+
+        this->pointer  = new_pointer;
+        this->capacity = new_capacity;
+        this->arena    = new_arena;
+    }
+
+    void reserve(i64 new_capacity) {
+        if (new_capacity > this->capacity) {
+            reallocate(new_capacity, this->arena);
+        }
+    }
+
+    void use_arena(Arena *arena) {
+        if (this->capacity == 0) {
+            this->arena = arena;
+            return;
+        }
+
+        reallocate(this->capacity, arena);
+    }
+
+    void push(T value) {
+        if (this->size == this->capacity) {
+            reallocate(std::max(this->capacity * 2, FIRST_CAPACITY), this->arena);
+        }
+
+        new (&this->pointer[this->size]) T(std::move(value));
+        this->size++;
+    }
+
+    T pop() {
+        __ASSERT(this->size > 0);
+        this->size--;
+        T value = std::move(this->pointer[this->size]);
+        this->pointer[this->size].~T();
+        return value;
+    }
+
+    void clear() {
+        for (i64 i = 0; i < this->size; i++) {
+            this->pointer[i].~T();
+        }
+        this->size = 0;
+    }
+
+    // the same as Slice, these give views into the array so they are only valid
+    // until it next grows
+    Slice<T> slice_full() const {
+        return Slice<T>(this->pointer, this->size);
+    }
+
+    Slice<T> slice_with_start_and_end(i64 start, i64 end) const {
+        return Slice<T>(&this->pointer[start], end - start);
+    }
+
+    Slice<T> slice_with_start(i64 start) const {
+        return Slice<T>(&this->pointer[start], this->size - start);
+    }
+
+    Slice<T> slice_with_end(i64 end) const {
+        return Slice<T>(this->pointer, end);
+    }
+
+    // used instead of the slice fns in debug builds
+    Slice<T> checked_slice_with_start_and_end(i64 start, i64 end, const char *file, i64 line) const {
+        check_slice_bounds(file, line, start, end, this->size);
+        return slice_with_start_and_end(start, end);
+    }
+
+    Slice<T> checked_slice_with_start(i64 start, const char *file, i64 line) const {
+        check_slice_bounds(file, line, start, this->size, this->size);
+        return slice_with_start(start);
+    }
+
+    Slice<T> checked_slice_with_end(i64 end, const char *file, i64 line) const {
+        check_slice_bounds(file, line, 0, end, this->size);
+        return slice_with_end(end);
+    }
+
+    T &operator[](i64 index) const {
+        return this->pointer[index];
+    }
+
+    T &checked_index(i64 index, const char *file, i64 line) const {
+        if (index < 0 || index >= this->size) {
+            bounds_panic(file, line, index, this->size);
+        }
+
+        return this->pointer[index];
+    }
+
+    void write_to(PrintBuffer &out) const {
+        slice_full().write_to(out);
+    }
+};
+
+// hashing for hash map keys. Numbers, bools and pointers go through the murmur3
+// finaliser so keys that only differ in a few bits still end up spread over the
+// whole table, the map uses the low 7 bits as a tag and the rest to pick a slot
+inline uint64_t hash_mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+inline uint64_t hash_combine(uint64_t seed, uint64_t value) {
+    return hash_mix(seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
+// structs used as keys get a hash fn from liamc
+template <typename T> uint64_t hash(const T &value) {
+    if constexpr (std::is_integral_v<T>) {
+        return hash_mix((uint64_t)value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        // -0.0 == 0.0 so they have to hash the same
+        T        normalised = value == 0 ? 0 : value;
+        uint64_t bits       = 0;
+        std::memcpy(&bits, &normalised, sizeof(T));
+        return hash_mix(bits);
+    } else if constexpr (std::is_pointer_v<T>) {
+        return hash_mix((uint64_t)(uintptr_t)value);
+    } else {
+        return value.hash();
+    }
+}
+
+// slices are hashed by what they point to so two strings with the same bytes are
+// the same key, bytes are taken 8 at a time
+template <typename T> uint64_t hash(const Slice<T> &value) {
+    uint64_t h = hash_mix((uint64_t)value.size);
+    if constexpr (std::is_integral_v<T> && sizeof(T) == 1) {
+        i64 i = 0;
+        for (; i + 8 <= value.size; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, &value.pointer[i], 8);
+            h = hash_combine(h, word);
+        }
+
+        uint64_t tail = 0;
+        std::memcpy(&tail, &value.pointer[i], value.size - i);
+        return hash_combine(h, tail);
+    } else {
+        for (i64 i = 0; i < value.size; i++) {
+            h = hash_combine(h, hash(value.pointer[i]));
+        }
+        return h;
+    }
+}
+
+template <typename T> bool equal(const T &a, const T &b) {
+    return a == b;
+}
+
+template <typename T> bool equal(const Slice<T> &a, const Slice<T> &b) {
+    if (a.size != b.size) {
+        return false;
+    }
+
+    if constexpr (std::is_integral_v<T>) {
+        return a.size == 0 || std::memcmp(a.pointer, b.pointer, sizeof(T) * a.size) == 0;
+    } else {
+        for (i64 i = 0; i < a.size; i++) {
+            if (!equal(a.pointer[i], b.pointer[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+// open addressing hash map, HashMap[K, V] in liam. This is laid out like a swiss
+// table, next to the entries is a control byte per slot that is EMPTY, DELETED or
+// the low 7 bits of the key's hash, the rest of the hash picks the slot. Finding a
+// key loads 16 control bytes at once and compares them all to the tag with sse2 so
+// most lookups only call equal on the key they are looking for. The control bytes
+// have the first group copied on the end so a group can be loaded starting at any slot.
+// The table grows to keep it at most 7/8 full, erasing leaves a DELETED slot so
+// the probe sequences going through it still work, they are reused by inserts
+// and cleared when the table next grows. Slice keys only point to their values
+// so what they point to has to outlive the map
+template <typename K, typename V> struct HashMap {
+    static constexpr i64 GROUP_SIZE     = 16;
+    static constexpr i64 FIRST_CAPACITY = 16;
+    static constexpr i8  EMPTY          = -128;
+    static constexpr i8  DELETED        = -2;
+
+    struct Entry {
+        K key;
+        V value;
+    };
+
+    i8    *control;     // capacity + GROUP_SIZE bytes
+    Entry *entries;     // only the ones with a tag in control are constructed
+    i64    capacity;    // 0 or a power of 2
+    i64    size;
+    i64    growth_left; // inserts into empty slots left before it has to grow
+
+    HashMap() {
+        this->control     = NULL;
+        this->entries     = NULL;
+        this->capacity    = 0;
+        this->size        = 0;
+        this->growth_left = 0;
+    }
+
+    HashMap(const HashMap<K, V> &other) : HashMap() {
+        if (other.capacity == 0) {
+            return;
+        }
+
+        // same capacity so every entry can go in the same slot without hashing it
+        allocate(other.capacity);
+        std::memcpy(this->control, other.control, other.capacity + GROUP_SIZE);
+        for (i64 i = 0; i < other.capacity; i++) {
+            if (other.control[i] >= 0) {
+                new (&this->entries[i]) Entry(other.entries[i]);
+            }
+        }
+        this->size        = other.size;
+        this->growth_left = other.growth_left;
+    }
+
+    HashMap(HashMap<K, V> &&other) noexcept {
+        this->control     = other.control;
+        this->entries     = other.entries;
+        this->capacity    = other.capacity;
+        this->size        = other.size;
+        this->growth_left = other.growth_left;
+        new (&other) HashMap<K, V>();
+    }
+
+    HashMap<K, V> &operator=(const HashMap<K, V> &other) {
+        if (this != &other) {
+            this->~HashMap();
+            new (this) HashMap<K, V>(other);
+        }
+
+        return *this;
+    }
+
+    HashMap<K, V> &operator=(HashMap<K, V> &&other) noexcept {
+        if (this != &other) {
+            this->~HashMap();
+            new (this) HashMap<K, V>(std::move(other));
+        }
+
+        return *this;
+    }
+
+    ~HashMap() {
+        destroy_entries();
+        std::free(this->control);
+        std::free(this->entries);
+    }
+
+    // bit i is set if control byte i of the group is tag
+    static uint32_t match(const i8 *group, i8 tag) {
+#if defined(__SSE2__)
+        __m128i bytes = _mm_loadu_si128((const __m128i *)group);
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(tag)));
+#else
+        uint32_t mask = 0;
+        for (i64 i = 0; i < GROUP_SIZE; i++) {
+            mask |= (uint32_t)(group[i] == tag) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // EMPTY and DELETED are the only negative control bytes so this is the sign bits
+    static uint32_t match_empty_or_deleted(const i8 *group) {
+#if defined(__SSE2__)
+        return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+        uint32_t mask = 0;
+        for (i64 i = 0; i < GROUP_SIZE; i++) {
+            mask |= (uint32_t)(group[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+    static i64 first_slot(uint32_t mask) {
+        return __builtin_ctz(mask);
+    }
+
+    void allocate(i64 new_capacity) {
+        this->control  = (i8 *)allocate_chunk(new_capacity + GROUP_SIZE, GROUP_SIZE);
+        this->entries  = (Entry *)allocate_chunk(sizeof(Entry) * new_capacity, alignof(Entry));
+        this->capacity = new_capacity;
+        std::memset(this->control, EMPTY, new_capacity + GROUP_SIZE);
+        this->growth_left = new_capacity - new_capacity / 8;
+    }
+
+    void destroy_entries() {
+        for (i64 i = 0; i < this->capacity; i++) {
+            if (this->control[i] >= 0) {
+                this->entries[i].~Entry();
+            }
+        }
+    }
+
+    void set_control(i64 slot, i8 value) {
+        this->control[slot] = value;
+        if (slot < GROUP_SIZE) {
+            this->control[this->capacity + slot] = value;
+        }
+    }
+
+    // groups are probed 1, 2, 3... groups apart which visits every group once
+    // when the number of groups is a power of 2
+    i64 find_slot(const K &key, uint64_t h) const {
+        if (this->capacity == 0) {
+            return -1;
+        }
+
+        i64 mask = this->capacity - 1;
+        i8  tag  = (i8)(h & 0x7f);
+        i64 slot = (i64)(h >> 7) & mask;
+        for (i64 step = GROUP_SIZE;; step += GROUP_SIZE) {
+            const i8 *group   = &this->control[slot];
+            uint32_t  matches = match(group, tag);
+            while (matches != 0) {
+                i64 i = (slot + first_slot(matches)) & mask;
+                if (equal(this->entries[i].key, key)) {
+                    return i;
+                }
+                matches &= matches - 1;
+            }
+
+            // the key would of been put in this empty slot so it is not in the map
+            if (match(group, EMPTY) != 0) {
+                return -1;
+            }
+
+            slot = (slot + step) & mask;
+        }
+    }
+
+    // the first empty or deleted slot in the probe sequence of h
+    i64 find_free_slot(uint64_t h) const {
+        i64 mask = this->capacity - 1;
+        i64 slot = (i64)(h >> 7) & mask;
+        for (i64 step = GROUP_SIZE;; step += GROUP_SIZE) {
+            uint32_t free = match_empty_or_deleted(&this->control[slot]);
+            if (free != 0) {
+                return (slot + first_slot(free)) & mask;
+            }
+
+            slot = (slot + step) & mask;
+        }
+    }
+
+    // moves every entry into a table big enough for new_size entries, this is also
+    // how DELETED slots get cleared as the new table has none
+    void rehash(i64 new_size) {
+        i64 new_capacity = FIRST_CAPACITY;
+        while (new_capacity - new_capacity / 8 < new_size) {
+            new_capacity *= 2;
+        }
+
+        i8    *old_control  = this->control;
+        Entry *old_entries  = this->entries;
+        i64    old_capacity = this->capacity;
+        allocate(new_capacity);
+
+        for (i64 i = 0; i < old_capacity; i++) {
+            if (old_control[i] < 0) {
+                continue;
+            }
+
+            uint64_t h    = Liam::hash(old_entries[i].key);
+            i64      slot = find_free_slot(h);
+            set_control(slot, (i8)(h & 0x7f));
+            new (&this->entries[slot]) Entry(std::move(old_entries[i]));
+            old_entries[i].~Entry();
+        }
+        this->growth_left -= this->size;
+
+        std::free(old_control);
+        std::free(old_entries);
+    }
+
+    V *find(const K &key) const {
+        i64 slot = find_slot(key, Liam::hash(key));
+        return slot < 0 ? NULL : &this->entries[slot].value;
+    }
+
+    bool contains(const K &key) const {
+        return find_slot(key, Liam::hash(key)) >= 0;
+    }
+
+    void insert(K key, V value) {
+        uint64_t h    = Liam::hash(key);
+        i64      slot = find_slot(key, h);
+        if (slot >= 0) {
+            this->entries[slot].value = std::move(value);
+            return;
+        }
+
+        if (this->growth_left == 0) {
+            rehash(this->size + 1);
+        }
+
+        slot = find_free_slot(h);
+        if (this->control[slot] == EMPTY) {
+            this->growth_left--;
+        }
+        set_control(slot, (i8)(h & 0x7f));
+        new (&this->entries[slot]) Entry{std::move(key), std::move(value)};
+        this->size++;
+    }
+
+    bool erase(const K &key) {
+        i64 slot = find_slot(key, Liam::hash(key));
+        if (slot < 0) {
+            return false;
+        }
+
+        this->entries[slot].~Entry();
+        set_control(slot, DELETED);
+        this->size--;
+        return true;
+    }
+
+    void reserve(i64 new_size) {
+        if (new_size > this->size + this->growth_left) {
+            rehash(new_size);
+        }
+    }
+
+    void clear() {
+        if (this->capacity == 0) {
+            return;
+        }
+
+        destroy_entries();
+        std::memset(this->control, EMPTY, this->capacity + GROUP_SIZE);
+        this->size        = 0;
+        this->growth_left = this->capacity - this->capacity / 8;
+    }
+
+    // goes through the full slots in slot order, skipping a group of empty ones at a time
+    struct Iterator {
+        const HashMap<K, V> *map;
+        i64                  slot;
+
+        void skip_free_slots() {
+            while (this->slot < this->map->capacity) {
+                uint32_t full = ~match_empty_or_deleted(&this->map->control[this->slot]) & 0xffff;
+                if (full != 0) {
+                    this->slot = std::min(this->slot + first_slot(full), this->map->capacity);
+                    return;
+                }
+                this->slot += GROUP_SIZE;
+            }
+            this->slot = this->map->capacity;
+        }
+
+        Entry &operator*() const {
+            return this->map->entries[this->slot];
+        }
+
+        Iterator &operator++() {
+            this->slot++;
+            skip_free_slots();
+            return *this;
+        }
+
+        bool operator!=(const Iterator &other) const {
+            return this->slot != other.slot;
+        }
+    };
+
+    Iterator begin() const {
+        Iterator iterator = Iterator{this, 0};
+        iterator.skip_free_slots();
+        return iterator;
+    }
+
+    Iterator end() const {
+        return Iterator{this, this->capacity};
+    }
+
+    void write_to(PrintBuffer &out) const {
+        out.append('{');
+        bool first = true;
+        for (Entry &entry : *this) {
+            if (!first) {
+                out.append(", ", 2);
+            }
+            write_value(out, entry.key);
+            out.append(": ", 2);
+            write_value(out, entry.value);
+            first = false;
+        }
+        out.append('}');
+    }
+};
+
+// map_file and map_file_rw in liam. The file is mapped into memory so nothing is
+// read until it is used and nothing is copied, the slice is the file. Writing to
+// a map_file slice crashes, writes to a map_file_rw one go to the file. A file
+// that can not be opened or is empty gives an empty slice
+#if defined(_WIN32)
+inline Slice<u8> map_file_with_protection(Slice<u8> path, bool writable) {
+    std::string path_string = std::string((const char *)path.pointer, path.size);
+    HANDLE      file = CreateFileA(path_string.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                                   FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return Slice<u8>(NULL, 0);
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return Slice<u8>(NULL, 0);
+    }
+
+    // the view keeps its own references to the mapping and the file
+    HANDLE mapping = CreateFileMappingA(file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL) {
+        return Slice<u8>(NULL, 0);
+    }
+
+    void *memory = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (memory == NULL) {
+        return Slice<u8>(NULL, 0);
+    }
+
+    return Slice<u8>((u8 *)memory, file_size.QuadPart);
+}
+#else
+inline Slice<u8> map_file_with_protection(Slice<u8> path, bool writable) {
+    std::string path_string = std::string((const char *)path.pointer, path.size);
+    int         file        = ::open(path_string.c_str(), writable ? O_RDWR : O_RDONLY);
+    if (file < 0) {
+        return Slice<u8>(NULL, 0);
+    }
+
+    struct stat file_stat;
+    if (fstat(file, &file_stat) < 0 || file_stat.st_size == 0) {
+        ::close(file);
+        return Slice<u8>(NULL, 0);
+    }
+
+    void *memory = mmap(NULL, file_stat.st_size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                        writable ? MAP_SHARED : MAP_PRIVATE, file, 0);
+
+    // the mapping keeps its own reference to the file
+    ::close(file);
+    if (memory == MAP_FAILED) {
+        return Slice<u8>(NULL, 0);
+    }
+
+    return Slice<u8>((u8 *)memory, file_stat.st_size);
+}
+#endif
+
+inline Slice<u8> map_file(Slice<u8> path) {
+    return map_file_with_protection(path, false);
+}
+
+inline Slice<u8> map_file_rw(Slice<u8> path) {
+    return map_file_with_protection(path, true);
+}
+
+// takes the whole slice a map_file gave back, not a part of it
+inline void unmap_file(Slice<u8> file) {
+    if (file.pointer != NULL) {
+#if defined(_WIN32)
+        UnmapViewOfFile(file.pointer);
+#else
+        munmap(file.pointer, file.size);
+#endif
+    }
+}
+
+// hints for how a mapped file is going to be used, any part of one can be given.
+// Sequential reads further ahead and random stops reading ahead at all. Windows has
+// no hints like these so they do nothing there
+#if defined(_WIN32)
+inline void advise_sequential(Slice<u8>) {
+}
+
+inline void advise_random(Slice<u8>) {
+}
+#else
+inline void advise_mapping(Slice<u8> data, int advice) {
+    if (data.size == 0) {
+        return;
+    }
+
+    // madvise wants a page aligned start
+    uintptr_t page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start     = (uintptr_t)data.pointer;
+    uintptr_t aligned   = start & ~(page_size - 1);
+    madvise((void *)aligned, start - aligned + data.size, advice);
+}
+
+inline void advise_sequential(Slice<u8> data) {
+    advise_mapping(data, MADV_SEQUENTIAL);
+}
+
+inline void advise_random(Slice<u8> data) {
+    advise_mapping(data, MADV_RANDOM);
+}
+#endif
+
+// set on threads while they run a parallel_for, a parallel_for inside one runs
+// on the thread it is on as all the others are already busy
+inline thread_local bool in_parallel_for = false;
+
+// a fixed set of threads started the first time a for par runs, the thread
+// calling run is used as worker 0 so there is one extra thread per core. It is
+// never destroyed so a panic calling exit on a worker does not try to join itself
+struct ThreadPool {
+    std::vector<std::thread>         threads;
+    std::mutex                       mutex;
+    std::condition_variable          wake;
+    std::condition_variable          done;
+    const std::function<void(i64)> *job;
+    i64                              generation;
+    i64                              pending;
+
+    static ThreadPool &get() {
+        static ThreadPool *pool = new ThreadPool(std::max((i64)std::thread::hardware_concurrency(), (i64)1));
+        return *pool;
+    }
+
+    ThreadPool(i64 worker_count) {
+        this->job        = NULL;
+        this->generation = 0;
+        this->pending    = 0;
+        for (i64 i = 1; i < worker_count; i++) {
+            this->threads.emplace_back([this, i]() { this->worker(i); });
+            this->threads.back().detach();
+        }
+    }
+
+    i64 worker_count() {
+        return this->threads.size() + 1;
+    }
+
+    void worker(i64 index) {
+        i64 seen_generation = 0;
+        while (true) {
+            const std::function<void(i64)> *job;
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->wake.wait(lock, [&]() { return this->generation != seen_generation; });
+                seen_generation = this->generation;
+                job             = this->job;
+            }
+
+            in_parallel_for = true;
+            (*job)(index);
+            in_parallel_for = false;
+            flush_print_buffer();
+
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->pending--;
+            if (this->pending == 0) {
+                this->done.notify_one();
+            }
+        }
+    }
+
+    // runs job(worker_index) on every worker and waits for all of them to finish
+    void run(const std::function<void(i64)> &job) {
+        // anything printed before the loop has to come out before what the workers print
+        flush_print_buffer();
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->job     = &job;
+            this->pending = this->threads.size();
+            this->generation++;
+        }
+        this->wake.notify_all();
+
+        in_parallel_for = true;
+        job(0);
+        in_parallel_for = false;
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->done.wait(lock, [&]() { return this->pending == 0; });
+    }
+};
+
+// the part of the iterations a worker starts with, on its own cache line so
+// workers taking chunks do not slow each other down
+struct alignas(64) WorkRange {
+    std::atomic<i64> next;
+    i64              end;
+};
+
+// runs body(chunk_begin, chunk_end) over [begin, end) in chunks of grain on every
+// worker. Each worker starts on its own equal part of the range and when that
+// runs out steals chunks from the parts of the others, so uneven iterations are
+// balanced out. A grain of 0 picks one that gives each worker about 8 chunks
+template <typename F> void parallel_for(i64 begin, i64 end, i64 grain, F body) {
+    i64 count = end - begin;
+    if (count <= 0) {
+        return;
+    }
+
+    ThreadPool &pool    = ThreadPool::get();
+    i64         workers = pool.worker_count();
+    if (grain <= 0) {
+        grain = std::max(count / (workers * 8), (i64)1);
+    }
+
+    if (in_parallel_for || workers == 1 || count <= grain) {
+        body(begin, end);
+        return;
+    }
+
+    std::unique_ptr<WorkRange[]> ranges = std::unique_ptr<WorkRange[]>(new WorkRange[workers]);
+    for (i64 i = 0; i < workers; i++) {
+        ranges[i].next = begin + count * i / workers;
+        ranges[i].end  = begin + count * (i + 1) / workers;
+    }
+
+    std::function<void(i64)> job = [&](i64 worker) {
+        for (i64 offset = 0; offset < workers; offset++) {
+            WorkRange &range = ranges[(worker + offset) % workers];
+            while (true) {
+                i64 chunk_begin = range.next.fetch_add(grain);
+                if (chunk_begin >= range.end) {
+                    break;
+                }
+
+                body(chunk_begin, std::min(chunk_begin + grain, range.end));
+            }
+        }
+    };
+
+    pool.run(job);
+}
+
+// the signed integer with the same size as T, comparing vectors gives a mask
+// of these with every bit set in the lanes where it was true
+template <i64 BYTES> struct SignedOfSize;
+template <> struct SignedOfSize<1> {
+    typedef i8 type;
+};
+template <> struct SignedOfSize<2> {
+    typedef i16 type;
+};
+template <> struct SignedOfSize<4> {
+    typedef i32 type;
+};
+template <> struct SignedOfSize<8> {
+    typedef i64 type;
+};
+
+// simd vectors using the gcc/clang vector extensions, arithmetic is done
+// with the native vector ops and the rest are loops over the lanes which the
+// c++ compiler turns into the matching instructions. This is an aggregate like
+// StaticArray so Vector{native} works
+template <typename T, i64 N> struct Vector {
+    typedef T                                              Native __attribute__((vector_size(sizeof(T) * N)));
+    typedef Vector<typename SignedOfSize<sizeof(T)>::type, N> Mask;
+
+    static constexpr i64 size = N;
+
+    // the initializer is needed for gcc to convert {} (liam zero) to a Vector
+    Native value = {};
+
+    template <typename... Lanes> static Vector make(Lanes... lanes) {
+        return Vector{Native{lanes...}};
+    }
+
+    static Vector splat(T lane) {
+        Vector vector;
+        for (i64 i = 0; i < N; i++) {
+            vector.value[i] = lane;
+        }
+        return vector;
+    }
+
+    // memcpy as the slice does not have to be aligned to the vector size
+    static Vector load(Slice<T> slice, i64 index) {
+        __ASSERT(index >= 0 && index + N <= slice.size);
+        Vector vector;
+        memcpy(&vector.value, &slice.pointer[index], sizeof(Native));
+        return vector;
+    }
+
+    void store(Slice<T> slice, i64 index) const {
+        __ASSERT(index >= 0 && index + N <= slice.size);
+        memcpy(&slice.pointer[index], &this->value, sizeof(Native));
+    }
+
+    // lanes are returned by value as c++ can not reference a vector lane
+    T operator[](i64 index) const {
+        return this->value[index];
+    }
+
+    // used instead of [] in debug builds
+    T checked_index(i64 index, const char *file, i64 line) const {
+        if (index < 0 || index >= N) {
+            bounds_panic(file, line, index, N);
+        }
+
+        return this->value[index];
+    }
+
+    T sum() const {
+        T result = this->value[0];
+        for (i64 i = 1; i < N; i++) {
+            result += this->value[i];
+        }
+        return result;
+    }
+
+    T min() const {
+        T result = this->value[0];
+        for (i64 i = 1; i < N; i++) {
+            result = this->value[i] < result ? this->value[i] : result;
+        }
+        return result;
+    }
+
+    T max() const {
+        T result = this->value[0];
+        for (i64 i = 1; i < N; i++) {
+            result = this->value[i] > result ? this->value[i] : result;
+        }
+        return result;
+    }
+
+    // N is always a power of 2 so indices wrap around
+    Vector shuffle(Mask indices) const {
+        Vector result;
+        for (i64 i = 0; i < N; i++) {
+            result.value[i] = this->value[indices.value[i] & (N - 1)];
+        }
+        return result;
+    }
+
+    Vector select(Mask mask, Vector other) const {
+        Vector result;
+        for (i64 i = 0; i < N; i++) {
+            result.value[i] = mask.value[i] ? this->value[i] : other.value[i];
+        }
+        return result;
+    }
+
+    bool any() const {
+        for (i64 i = 0; i < N; i++) {
+            if (this->value[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool all() const {
+        for (i64 i = 0; i < N; i++) {
+            if (!this->value[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend Vector operator+(Vector a, Vector b) {
+        return Vector{a.value + b.value};
+    }
+
+    friend Vector operator-(Vector a, Vector b) {
+        return Vector{a.value - b.value};
+    }
+
+    friend Vector operator*(Vector a, Vector b) {
+        return Vector{a.value * b.value};
+    }
+
+    friend Vector operator/(Vector a, Vector b) {
+        return Vector{a.value / b.value};
+    }
+
+    friend Vector operator%(Vector a, Vector b) {
+        return Vector{a.value % b.value};
+    }
+
+    friend Vector operator-(Vector a) {
+        return Vector{-a.value};
+    }
+
+    // comparisons give a native mask the same size as Native, the cast is only
+    // for the 64 bit lanes which can be long or long long
+    friend Mask operator<(Vector a, Vector b) {
+        return Mask{(typename Mask::Native)(a.value < b.value)};
+    }
+
+    friend Mask operator>(Vector a, Vector b) {
+        return Mask{(typename Mask::Native)(a.value > b.value)};
+    }
+
+    friend Mask operator<=(Vector a, Vector b) {
+        return Mask{(typename Mask::Native)(a.value <= b.value)};
+    }
+
+    friend Mask operator>=(Vector a, Vector b) {
+        return Mask{(typename Mask::Native)(a.value >= b.value)};
+    }
+
+    friend Mask operator==(Vector a, Vector b) {
+        return Mask{(typename Mask::Native)(a.value == b.value)};
+    }
+
+    friend Mask operator!=(Vector a, Vector b) {
+        return Mask{(typename Mask::Native)(a.value != b.value)};
+    }
+
+    void write_to(PrintBuffer &out) const {
+        out.append('[');
+        for (i64 i = 0; i < N; i++) {
+            write_value(out, (T)this->value[i]);
+            if (i != N - 1) {
+                out.append(", ", 2);
             }
         }
-        os << "]";
-        return os;
+        out.append(']');
     }
 };
 } // namespace Liam
+
+// the liam name for the builtin arena type, Pool[T] is always written as Liam::Pool<T>
+typedef Liam::Arena Arena;
+
+// the liam names for the vector types, same as the ones in the compilers global type scope
+typedef Liam::Vector<i8, 16>  i8x16;
+typedef Liam::Vector<i8, 32>  i8x32;
+typedef Liam::Vector<u8, 16>  u8x16;
+typedef Liam::Vector<u8, 32>  u8x32;
+typedef Liam::Vector<i16, 8>  i16x8;
+typedef Liam::Vector<i16, 16> i16x16;
+typedef Liam::Vector<i32, 4>  i32x4;
+typedef Liam::Vector<i32, 8>  i32x8;
+typedef Liam::Vector<f32, 4>  f32x4;
+typedef Liam::Vector<f32, 8>  f32x8;
+typedef Liam::Vector<i64, 2>  i64x2;
+typedef Liam::Vector<i64, 4>  i64x4;
+typedef Liam::Vector<f64, 2>  f64x2;
+typedef Liam::Vector<f64, 4>  f64x4;
@@ -2,9 +2,7 @@
 #include "cxxopts/cxxopts.h"
 #include <vector>
 
-Arguments *args      = NULL;
-
-std::string zen_text = R"(
+std::string zen_of_liam = R"(
     * There should only be one obvious way to do things
     * Simplicity and speed should be prioritised more then anything else
     * Longer doesn't mean less readable and shorter doesn't mean smarter
@@ -13,8 +11,8 @@ std::string zen_text = R"(
     * Errors are not exceptional
     * Reduce developer pain as much as possible)";
 
-void Arguments::make(int argc, char **argv) {
-    args         = new Arguments{};
+Arguments *Arguments::make(int argc, char **argv) {
+    auto args    = new Arguments{};
     auto options = new cxxopts::Options("liamc", "Liam programming language compiler");
 
     // optionals with defaults
@@ -25,28 +23,58 @@ void Arguments::make(int argc, char **argv) {
     options->add_options()("h,help", "See this help screen", cxxopts::value<bool>()->default_value("false"));
     options->add_options()("z,zen", "See the zen of Liam", cxxopts::value<bool>()->default_value("false"));
     options->add_options()("T,test", "Build binary to run tests", cxxopts::value<bool>()->default_value("false"));
+    options->add_options()("trace", "Write a chrome trace of the compiler to the given path",
+                           cxxopts::value<std::string>()->default_value(""));
+    options->add_options()("p,profile", "Build profile, debug or release",
+                           cxxopts::value<std::string>()->default_value("debug"));
+    options->add_options()("mem-stats", "Print memory used after each phase",
+                           cxxopts::value<bool>()->default_value("false"));
     options->add_options()("f,files", "Input files to compile",
                            cxxopts::value<std::vector<std::string>>()->default_value({}));
 
     options->parse_positional({"files"});
 
-    args->result  = options->parse(argc, argv);
     args->options = options;
 
-    if (args->result.count("help")) {
-        std::cout << options->help() << std::endl;
-        exit(0);
+    try {
+        args->result = options->parse(argc, argv);
+    } catch (const cxxopts::OptionException &exception) {
+        args->error = exception.what();
+        return args;
     }
 
-    if (args->result.count("zen")) {
-        std::cout << zen_text << std::endl;
-        exit(0);
-    }
+    args->help = args->result.count("help");
+    args->zen  = args->result.count("zen");
 
     // optional
-    args->out_path = args->value<std::string>("out");
-    args->emit     = args->value<bool>("emit");
-    args->time     = args->value<bool>("time");
-    args->test     = args->value<bool>("test");
-    args->files    = args->value<std::vector<std::string>>("files");
+    args->out_path   = args->value<std::string>("out");
+    args->emit       = args->value<bool>("emit");
+    args->time       = args->value<bool>("time");
+    args->test       = args->value<bool>("test");
+    args->files      = args->value<std::vector<std::string>>("files");
+    args->trace_path = args->value<std::string>("trace");
+    args->mem_stats  = args->value<bool>("mem-stats");
+
+    std::string profile = args->value<std::string>("profile");
+    if (profile == "debug") {
+        args->profile = Profile::DEBUG;
+    } else if (profile == "release") {
+        args->profile = Profile::RELEASE;
+    } else {
+        args->error = "Unknown profile '" + profile + "', use debug or release";
+    }
+
+    return args;
+}
+
+Arguments::~Arguments() {
+    delete this->options;
+}
+
+std::string Arguments::help_text() {
+    return this->options->help();
+}
+
+std::string Arguments::zen_text() {
+    return zen_of_liam;
 }
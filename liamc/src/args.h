@@ -5,8 +5,12 @@
 
 #include "liam.h"
 
-struct Arguments;
-extern Arguments *args;
+// debug checks every index into arrays and slices and keeps asserts, release
+// does neither and is compiled with optimisations on
+enum class Profile {
+    DEBUG,
+    RELEASE
+};
 
 struct Arguments {
     std::string              out_path;
@@ -15,11 +19,28 @@ struct Arguments {
     std::string              include;
     bool                     test;
     std::vector<std::string> files;
+    std::string              trace_path;
+    bool                     mem_stats;
+    Profile                  profile;
+    bool                     help;
+    bool                     zen;
 
     cxxopts::Options    *options;
     cxxopts::ParseResult result;
 
-    static void make(int argc, char **argv);
+    // liamc_lib can be run inside another program so nothing here exits, if the
+    // arguments cannot be used the error is set and the caller decides what to do
+    std::string error;
+
+    static Arguments *make(int argc, char **argv);
+    ~Arguments();
+
+    Arguments()                             = default;
+    Arguments(const Arguments &)            = delete;
+    Arguments &operator=(const Arguments &) = delete;
+
+    std::string help_text();
+    std::string zen_text();
 
     template <typename T> T value(std::string option) {
         return this->result[option].as<T>();
@@ -1,8 +1,45 @@
 #include "ast.h"
+#include "baseLayer/debug.h"
 #include "compilation_unit.h"
 
 #include <tuple>
 
+thread_local NodePool *NodePool::active = NULL;
+
+void *Node::operator new(size_t size) {
+    void *node = ::operator new(size);
+    if (NodePool::active != NULL) {
+        NodePool::active->nodes.push_back((Node *)node);
+    }
+
+    return node;
+}
+
+NodePool::~NodePool() {
+    this->free_nodes();
+}
+
+void NodePool::free_nodes() {
+    for (auto node : this->nodes) {
+        delete node;
+    }
+
+    this->nodes.clear();
+}
+
+ActiveNodePool::ActiveNodePool(NodePool *pool) {
+    this->previous   = NodePool::active;
+    NodePool::active = pool;
+}
+
+ActiveNodePool::~ActiveNodePool() {
+    NodePool::active = this->previous;
+}
+
+AnyTypeInfo::AnyTypeInfo() {
+    this->type = TypeInfoType::ANY;
+}
+
 VoidTypeInfo::VoidTypeInfo() {
     this->type = TypeInfoType::VOID;
 }
@@ -26,20 +63,42 @@ StrTypeInfo::StrTypeInfo() {
     this->type = TypeInfoType::STRING;
 }
 
-TypeTypeInfo::TypeTypeInfo() {
+u64 number_size_bytes(NumberSize size) {
+    switch (size) {
+    case NumberSize::SIZE_8:
+        return 1;
+    case NumberSize::SIZE_16:
+        return 2;
+    case NumberSize::SIZE_32:
+        return 4;
+    case NumberSize::SIZE_64:
+        return 8;
+    default:
+        UNREACHABLE();
+    }
+}
+
+TypeTypeInfo::TypeTypeInfo(TypeInfo *of) {
+    this->of   = of;
+    this->type = TypeInfoType::TYPE;
 }
 
 StructTypeInfo::StructTypeInfo(StructStatement                                 *defined_location,
                                std::vector<std::tuple<std::string, TypeInfo *>> members) {
     this->defined_location = defined_location;
     this->members          = members;
+    this->size             = 0;
+    this->alignment        = 0;
+    this->is_hash_key      = false;
     this->type             = TypeInfoType::STRUCT;
 }
 
 FnTypeInfo::FnTypeInfo(TypeInfo *returnType, std::vector<TypeInfo *> args) {
-    this->return_type = returnType;
-    this->args        = args;
-    this->type        = TypeInfoType::FN;
+    this->return_type       = returnType;
+    this->args              = args;
+    this->is_builtin        = false;
+    this->generic_statement = NULL;
+    this->type              = TypeInfoType::FN;
 }
 
 NamespaceTypeInfo::NamespaceTypeInfo(u64 compilation_unit_index) {
@@ -62,6 +121,33 @@ RangeTypeInfo::RangeTypeInfo() {
     this->type = TypeInfoType::RANGE;
 }
 
+VectorTypeInfo::VectorTypeInfo(NumberTypeInfo *base_type, u64 lanes) {
+    this->base_type = base_type;
+    this->lanes     = lanes;
+    this->type      = TypeInfoType::VECTOR;
+}
+
+ArenaTypeInfo::ArenaTypeInfo() {
+    this->type = TypeInfoType::ARENA;
+}
+
+PoolTypeInfo::PoolTypeInfo(TypeInfo *base_type) {
+    this->base_type = base_type;
+    this->type      = TypeInfoType::POOL;
+}
+
+DynamicArrayTypeInfo::DynamicArrayTypeInfo(TypeInfo *base_type) {
+    this->base_type = base_type;
+    this->type      = TypeInfoType::DYNAMIC_ARRAY;
+}
+
+HashMapTypeInfo::HashMapTypeInfo(TypeInfo *key_type, TypeInfo *value_type) {
+    this->key_type   = key_type;
+    this->value_type = value_type;
+    this->entry_type = new StructTypeInfo(NULL, {{"key", key_type}, {"value", value_type}});
+    this->type       = TypeInfoType::HASH_MAP;
+}
+
 ExpressionStatement::ExpressionStatement(Expression *expression) {
     this->expression     = expression;
     this->statement_type = StatementType::EXPRESSION;
@@ -81,12 +167,17 @@ AssigmentStatement::AssigmentStatement(Expression *lhs, ExpressionStatement *ass
 }
 
 ForStatement::ForStatement(TokenIndex value_identifier, Expression *expression, ScopeStatement *body,
-                           ForType for_type) {
-    this->value_identifier = value_identifier;
-    this->expression       = expression;
-    this->body             = body;
-    this->for_type         = for_type;
-    this->statement_type   = StatementType::FOR;
+                           ForType for_type, bool value_is_pointer, bool is_parallel, Expression *grain, Tags tags) {
+    this->value_identifier   = value_identifier;
+    this->expression         = expression;
+    this->body               = body;
+    this->for_type           = for_type;
+    this->value_is_pointer   = value_is_pointer;
+    this->value_is_reference = false;
+    this->is_parallel        = is_parallel;
+    this->grain              = grain;
+    this->tags               = tags;
+    this->statement_type     = StatementType::FOR;
 }
 
 ScopeStatement::ScopeStatement(std::vector<Statement *> statements) {
@@ -95,28 +186,41 @@ ScopeStatement::ScopeStatement(std::vector<Statement *> statements) {
 }
 
 FnStatement::FnStatement(CompilationUnit *compilation_unit, TokenIndex identifier, CSV params, TypeExpression *type,
-                         ScopeStatement *body) {
-    this->compilation_unit = compilation_unit;
-    this->identifier       = identifier;
-    this->return_type      = type;
-    this->params           = params;
-    this->body             = body;
-    this->statement_type   = StatementType::FN;
+                         ScopeStatement *body, Tags tags, std::vector<Tags> param_tags, TokenIndex fn_token,
+                         std::vector<TokenIndex> generic_params) {
+    this->compilation_unit    = compilation_unit;
+    this->identifier          = identifier;
+    this->return_type         = type;
+    this->params              = params;
+    this->body                = body;
+    this->params_by_reference = std::vector<bool>(params.size(), false);
+    this->tags                = tags;
+    this->param_tags          = param_tags;
+    this->fn_token            = fn_token;
+    this->generic_params      = generic_params;
+    this->generic_arguments   = std::vector<TypeInfo *>();
+    this->instance_index      = 0;
+    this->generic_depth       = 0;
+    this->type_info           = NULL;
+    this->statement_type      = StatementType::FN;
 }
 
 StructStatement::StructStatement(CompilationUnit *compilation_unit, TokenIndex identifier, CSV members,
-                                 StructTypeInfo *type_info) {
+                                 StructTypeInfo *type_info, Tags tags, std::vector<Tags> member_tags) {
     this->compilation_unit = compilation_unit;
     this->identifier       = identifier;
     this->members          = members;
     this->type_info        = type_info;
+    this->tags             = tags;
+    this->member_tags      = member_tags;
     this->statement_type   = StatementType::STRUCT;
 }
 
-IfStatement::IfStatement(Expression *expression, ScopeStatement *body, ElseStatement *else_statement) {
+IfStatement::IfStatement(Expression *expression, ScopeStatement *body, ElseStatement *else_statement, Tags tags) {
     this->expression     = expression;
     this->body           = body;
     this->else_statement = else_statement;
+    this->tags           = tags;
     this->statement_type = StatementType::IF;
 }
 
@@ -157,10 +261,11 @@ AssertStatement::AssertStatement(Expression *expression) {
     this->expression     = expression;
 }
 
-WhileStatement::WhileStatement(Expression *expression, ScopeStatement *body) {
+WhileStatement::WhileStatement(Expression *expression, ScopeStatement *body, Tags tags) {
     this->statement_type = StatementType::WHILE;
     this->expression     = expression;
     this->body           = body;
+    this->tags           = tags;
 }
 
 std::ostream &Expression::format(std::ostream &os) const {
@@ -209,10 +314,11 @@ IdentifierExpression::IdentifierExpression(TokenIndex identifier, Span span) {
 }
 
 CallExpression::CallExpression(Expression *identifier, std::vector<Expression *> args) {
-    this->callee = identifier;
-    this->args   = args;
-    this->type   = ExpressionType::CALL;
-    this->span   = identifier->span;
+    this->callee           = identifier;
+    this->args             = args;
+    this->generic_instance = NULL;
+    this->type             = ExpressionType::CALL;
+    this->span             = identifier->span;
 }
 
 GetExpression::GetExpression(Expression *expression, TokenIndex member) {
@@ -246,11 +352,13 @@ InstantiateExpression::InstantiateExpression(Expression *expression) {
     this->span       = expression->span;
 }
 
-StructInstanceExpression::StructInstanceExpression(
-    TypeExpression *type_expression, std::vector<std::tuple<TokenIndex, Expression *>> named_expressions) {
+StructInstanceExpression::StructInstanceExpression(TypeExpression *type_expression,
+                                                   std::vector<std::tuple<TokenIndex, Expression *>> named_expressions,
+                                                   Expression                                       *allocator) {
     this->type              = ExpressionType::STRUCT_INSTANCE;
     this->type_expression   = type_expression;
     this->named_expressions = named_expressions;
+    this->allocator         = allocator;
     this->span              = type_expression->span;
 }
 
@@ -265,16 +373,35 @@ StaticArrayExpression::StaticArrayExpression(NumberLiteralExpression *number, Ty
 SubscriptExpression::SubscriptExpression(Expression *subscriptee, Expression *subscripter) {
     this->subscriptee = subscriptee;
     this->subscripter = subscripter;
+    this->in_bounds   = false;
     this->span        = subscripter->span;
     this->type        = ExpressionType::SUBSCRIPT;
 }
 
-RangeExpression::RangeExpression(Expression *start, Expression *end) {
+RangeExpression::RangeExpression(Expression *start, Expression *end, Span span) {
     this->start = start;
     this->end   = end;
-    this->span =
-        Span{}; // TODO: each expression might be null here so we need to figure out what to do here, maybe use the : ??
-    this->type = ExpressionType::RANGE;
+    this->span  = span;
+    this->type  = ExpressionType::RANGE;
+}
+
+ArenaSliceExpression::ArenaSliceExpression(Expression *arena, TypeExpression *type_expression, Expression *count,
+                                           Span span) {
+    this->arena           = arena;
+    this->type_expression = type_expression;
+    this->count           = count;
+    this->span            = span;
+    this->type            = ExpressionType::ARENA_SLICE;
+}
+
+EmbedExpression::EmbedExpression(TokenIndex path, TypeExpression *element_type, Span span) {
+    this->path          = path;
+    this->element_type  = element_type;
+    this->absolute_path = "";
+    this->byte_size     = 0;
+    this->index         = 0;
+    this->span          = span;
+    this->type          = ExpressionType::EMBED;
 }
 
 std::ostream &TypeExpression::format(std::ostream &os) const {
@@ -287,9 +414,10 @@ std::ostream &operator<<(std::ostream &os, const TypeExpression &expression) {
 }
 
 IdentifierTypeExpression::IdentifierTypeExpression(TokenIndex identifier, Span span) {
-    this->identifier = identifier;
-    this->type       = TypeExpressionType::TYPE_IDENTIFIER;
-    this->span       = span;
+    this->identifier       = identifier;
+    this->is_generic_param = false;
+    this->type             = TypeExpressionType::TYPE_IDENTIFIER;
+    this->span             = span;
 }
 
 UnaryTypeExpression::UnaryTypeExpression(UnaryType unary_type, TypeExpression *type_expression) {
@@ -318,3 +446,22 @@ SliceTypeExpression::SliceTypeExpression(TypeExpression *base_type) {
     this->span      = base_type->span;
     this->type      = TypeExpressionType::TYPE_SLICE;
 }
+
+PoolTypeExpression::PoolTypeExpression(TypeExpression *base_type, Span span) {
+    this->base_type = base_type;
+    this->span      = span;
+    this->type      = TypeExpressionType::TYPE_POOL;
+}
+
+DynamicArrayTypeExpression::DynamicArrayTypeExpression(TypeExpression *base_type) {
+    this->base_type = base_type;
+    this->span      = base_type->span;
+    this->type      = TypeExpressionType::TYPE_DYNAMIC_ARRAY;
+}
+
+HashMapTypeExpression::HashMapTypeExpression(TypeExpression *key_type, TypeExpression *value_type, Span span) {
+    this->key_type   = key_type;
+    this->value_type = value_type;
+    this->span       = span;
+    this->type       = TypeExpressionType::TYPE_HASH_MAP;
+}
@@ -44,6 +44,9 @@ struct TypeExpression;
 struct IdentifierTypeExpression;
 struct UnaryTypeExpression;
 struct StaticArrayTypeExpression;
+struct PoolTypeExpression;
+struct DynamicArrayTypeExpression;
+struct HashMapTypeExpression;
 struct CompilationUnit;
 
 struct TypeInfo;
@@ -59,9 +62,68 @@ struct NamespaceTypeInfo;
 struct StaticArrayTypeInfo;
 struct SliceTypeInfo;
 struct RangeTypeInfo;
+struct VectorTypeInfo;
+struct ArenaTypeInfo;
+struct PoolTypeInfo;
+struct DynamicArrayTypeInfo;
+struct HashMapTypeInfo;
 
 typedef std::vector<std::tuple<TokenIndex, TypeExpression *>> CSV;
 
+struct NodePool;
+
+// statements, expressions, type expressions and type infos point at each other freely
+// and type infos are shared, so none of them owns another. Instead every one made with
+// new while a node pool is active on this thread is kept in it and freed with it
+struct Node {
+    static void *operator new(size_t size);
+    virtual ~Node() = default;
+};
+
+struct NodePool {
+    std::vector<Node *> nodes;
+
+    // the pool new nodes go in on this thread, NULL when there is none and they are never freed
+    static thread_local NodePool *active;
+
+    NodePool() = default;
+    ~NodePool();
+
+    NodePool(const NodePool &)            = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    void free_nodes();
+};
+
+// makes a pool the active one until the end of the scope, putting back the one before it
+struct ActiveNodePool {
+    NodePool *previous;
+
+    ActiveNodePool(NodePool *pool);
+    ~ActiveNodePool();
+};
+
+// tags go before a struct, a struct member, a fn or a fn param e.g. #packed or #align(64),
+// or after an if, while or for e.g. if #unlikely x, each one sets its bit in Tags::flags
+enum TagFlag : u16 {
+    TAG_ALIGN    = 1 << 0,
+    TAG_PACKED   = 1 << 1,
+    TAG_INLINE   = 1 << 2,
+    TAG_NOINLINE = 1 << 3,
+    TAG_HOT      = 1 << 4,
+    TAG_COLD     = 1 << 5,
+    TAG_FLATTEN  = 1 << 6,
+    TAG_LIKELY   = 1 << 7,
+    TAG_UNLIKELY = 1 << 8,
+    TAG_SIMD     = 1 << 9,
+    TAG_NOALIAS  = 1 << 10,
+};
+
+struct Tags {
+    u16 flags;
+    u64 alignment; // n in #align(n), 0 if not tagged with it
+};
+
 enum class StatementType {
     UNDEFINED = 0,
     EXPRESSION,
@@ -99,7 +161,9 @@ enum class ExpressionType {
     INSTANTIATION,
     STRUCT_INSTANCE,
     STATIC_ARRAY,
-    RANGE
+    RANGE,
+    ARENA_SLICE,
+    EMBED
 };
 
 enum class ExpressionCategory {
@@ -112,7 +176,9 @@ enum class ForType {
     UNDEFINED = 0,
     RANGE,
     STATIC_ARRAY,
-    SLICE
+    SLICE,
+    DYNAMIC_ARRAY,
+    HASH_MAP
 };
 
 enum class UnaryType {
@@ -127,7 +193,10 @@ enum class TypeExpressionType {
     TYPE_UNARY,
     TYPE_GET,
     TYPE_STATIC_ARRAY,
-    TYPE_SLICE
+    TYPE_SLICE,
+    TYPE_POOL,
+    TYPE_DYNAMIC_ARRAY,
+    TYPE_HASH_MAP
 };
 
 enum class TypeInfoType {
@@ -142,7 +211,13 @@ enum class TypeInfoType {
     NAMESPACE,
     STATIC_ARRAY,
     SLICE,
-    RANGE
+    RANGE,
+    VECTOR,
+    TYPE,
+    ARENA,
+    POOL,
+    DYNAMIC_ARRAY,
+    HASH_MAP
 };
 
 enum class NumberType {
@@ -160,17 +235,21 @@ enum class NumberSize {
     SIZE_64
 };
 
+u64 number_size_bytes(NumberSize size);
+
 union NumberValue {
     u64 u;
     i64 i;
     f64 f;
 };
 
-struct TypeInfo {
+struct TypeInfo : Node {
     TypeInfoType type;
 };
 
-struct AnyTypeInfo : TypeInfo {};
+struct AnyTypeInfo : TypeInfo {
+    AnyTypeInfo();
+};
 
 struct VoidTypeInfo : TypeInfo {
     VoidTypeInfo();
@@ -197,13 +276,20 @@ struct StrTypeInfo : TypeInfo {
     StrTypeInfo();
 };
 
+// the type of a type name used in an expression, only vector types can be used
+// like this to get to their builtin fns e.g. f32x4.load(values, 0)
 struct TypeTypeInfo : TypeInfo {
-    TypeTypeInfo();
+    TypeInfo *of;
+
+    TypeTypeInfo(TypeInfo *of);
 };
 
 struct StructTypeInfo : TypeInfo {
     StructStatement                                 *defined_location;
     std::vector<std::tuple<std::string, TypeInfo *>> members;
+    u64                                              size;      // set after the structs are topologically sorted
+    u64                                              alignment; // same as size
+    bool                                             is_hash_key; // used as a HashMap key, gets == and a hash fn
 
     StructTypeInfo(StructStatement *defined_location, std::vector<std::tuple<std::string, TypeInfo *>> members);
 };
@@ -211,6 +297,8 @@ struct StructTypeInfo : TypeInfo {
 struct FnTypeInfo : TypeInfo {
     TypeInfo               *return_type;
     std::vector<TypeInfo *> args;
+    bool                    is_builtin;        // defined in core.h as Liam::name
+    FnStatement            *generic_statement; // set if generic, each call makes an instance of it
 
     FnTypeInfo(TypeInfo *returnType, std::vector<TypeInfo *> args);
 };
@@ -248,10 +336,46 @@ struct RangeTypeInfo : TypeInfo {
     RangeTypeInfo();
 };
 
+// simd vectors like f32x4, these are builtin types and are Liam::Vector in core.h
+struct VectorTypeInfo : TypeInfo {
+    NumberTypeInfo *base_type;
+    u64             lanes;
+
+    VectorTypeInfo(NumberTypeInfo *base_type, u64 lanes);
+};
+
+// the builtin allocators, Liam::Arena and Liam::Pool in core.h
+struct ArenaTypeInfo : TypeInfo {
+    ArenaTypeInfo();
+};
+
+struct PoolTypeInfo : TypeInfo {
+    TypeInfo *base_type;
+
+    PoolTypeInfo(TypeInfo *base_type);
+};
+
+// [dyn]T, Liam::Array in core.h
+struct DynamicArrayTypeInfo : TypeInfo {
+    TypeInfo *base_type;
+
+    DynamicArrayTypeInfo(TypeInfo *base_type);
+};
+
+// HashMap[K, V], Liam::HashMap in core.h
+// iterating a map gives its entries which look like a struct with a key and value member
+struct HashMapTypeInfo : TypeInfo {
+    TypeInfo       *key_type;
+    TypeInfo       *value_type;
+    StructTypeInfo *entry_type;
+
+    HashMapTypeInfo(TypeInfo *key_type, TypeInfo *value_type);
+};
+
 /*
     ======= STATEMENTS ========
 */
-struct Statement {
+struct Statement : Node {
     StatementType statement_type = StatementType::UNDEFINED;
 };
 
@@ -276,23 +400,36 @@ struct ScopeStatement : Statement {
 };
 
 struct FnStatement : Statement {
-    CompilationUnit *compilation_unit;
-    TokenIndex       identifier;
-    CSV              params;
-    TypeExpression  *return_type;
-    ScopeStatement  *body;
+    CompilationUnit        *compilation_unit;
+    TokenIndex              identifier;
+    CSV                     params;
+    TypeExpression         *return_type;
+    ScopeStatement         *body;
+    std::vector<bool>       params_by_reference; // set at type checking time, one for each param
+    Tags                    tags;
+    std::vector<Tags>       param_tags;        // one for each param
+    TokenIndex              fn_token;          // instances of a generic fn are parsed again from here
+    std::vector<TokenIndex> generic_params;    // fn max[T](...), empty when not generic
+    std::vector<TypeInfo *> generic_arguments; // what each generic param is, only set on instances
+    u64                     instance_index;    // the position in CompilationUnit::generic_fn_instances
+    u64                     generic_depth;     // how many instances deep this one was made from
+    FnTypeInfo             *type_info;         // set at type checking time
 
     FnStatement(CompilationUnit *compilation_unit, TokenIndex identifier, CSV params, TypeExpression *type,
-                ScopeStatement *body);
+                ScopeStatement *body, Tags tags, std::vector<Tags> param_tags, TokenIndex fn_token,
+                std::vector<TokenIndex> generic_params);
 };
 
 struct StructStatement : Statement {
-    CompilationUnit *compilation_unit;
-    TokenIndex       identifier;
-    CSV              members;
-    StructTypeInfo  *type_info;
+    CompilationUnit  *compilation_unit;
+    TokenIndex        identifier;
+    CSV               members;
+    StructTypeInfo   *type_info;
+    Tags              tags;
+    std::vector<Tags> member_tags; // one for each member
 
-    StructStatement(CompilationUnit *compilation_unit, TokenIndex identifier, CSV members, StructTypeInfo *type_info);
+    StructStatement(CompilationUnit *compilation_unit, TokenIndex identifier, CSV members, StructTypeInfo *type_info,
+                    Tags tags, std::vector<Tags> member_tags);
 };
 
 struct AssigmentStatement : Statement {
@@ -306,17 +443,25 @@ struct ForStatement : Statement {
     TokenIndex      value_identifier;
     Expression     *expression;
     ScopeStatement *body;
-    ForType for_type; // this is set at type checking time, based on the type of the expression we are iterating over
+    // this is set at type checking time, based on the type of the expression we are iterating over
+    ForType         for_type;
+    bool            value_is_pointer;   // for ^value : array { ... }
+    bool            value_is_reference; // set at type checking time if the body can use the value without copying it
+    bool            is_parallel;        // for par value : array { ... }
+    Expression     *grain;              // for par(grain) ..., iterations a thread takes at a time, NULL picks one
+    Tags            tags;               // for #simd value : array { ... }
 
-    ForStatement(TokenIndex value_identifier, Expression *expression, ScopeStatement *body, ForType for_type);
+    ForStatement(TokenIndex value_identifier, Expression *expression, ScopeStatement *body, ForType for_type,
+                 bool value_is_pointer, bool is_parallel, Expression *grain, Tags tags);
 };
 
 struct IfStatement : Statement {
     Expression     *expression;
     ScopeStatement *body;
     ElseStatement  *else_statement;
+    Tags            tags;
 
-    IfStatement(Expression *expression, ScopeStatement *body, ElseStatement *else_statement);
+    IfStatement(Expression *expression, ScopeStatement *body, ElseStatement *else_statement, Tags tags);
 };
 
 struct ElseStatement : Statement {
@@ -363,14 +508,15 @@ struct AssertStatement : Statement {
 struct WhileStatement : Statement {
     Expression     *expression;
     ScopeStatement *body;
+    Tags            tags;
 
-    WhileStatement(Expression *expression, ScopeStatement *body);
+    WhileStatement(Expression *expression, ScopeStatement *body, Tags tags);
 };
 
 /*
     ======= EXPRESSIONS ========
 */
-struct Expression {
+struct Expression : Node {
     Span                  span      = {};
     TypeInfo             *type_info = nullptr;
     ExpressionType        type      = ExpressionType::UNDEFINED;
@@ -423,6 +569,7 @@ struct IdentifierExpression : Expression {
 struct CallExpression : Expression {
     Expression               *callee;
     std::vector<Expression *> args;
+    FnStatement              *generic_instance; // set at type checking time when calling a generic fn
 
     CallExpression(Expression *identifier, std::vector<Expression *> args);
 };
@@ -461,9 +608,11 @@ struct InstantiateExpression : Expression {
 struct StructInstanceExpression : Expression {
     TypeExpression                                   *type_expression;
     std::vector<std::tuple<TokenIndex, Expression *>> named_expressions;
+    Expression                                       *allocator; // new(arena) T{...}, NULL for a plain new T{...}
 
     StructInstanceExpression(TypeExpression                                   *type_expression,
-                             std::vector<std::tuple<TokenIndex, Expression *>> named_expressions);
+                             std::vector<std::tuple<TokenIndex, Expression *>> named_expressions,
+                             Expression                                       *allocator);
 };
 
 struct StaticArrayExpression : Expression {
@@ -478,6 +627,7 @@ struct StaticArrayExpression : Expression {
 struct SubscriptExpression : Expression {
     Expression *subscriptee;
     Expression *subscripter;
+    bool        in_bounds; // set at type checking time if the index can never be out of bounds
 
     SubscriptExpression(Expression *subscriptee, Expression *subscripter);
 };
@@ -486,13 +636,35 @@ struct RangeExpression : Expression {
     Expression *start;
     Expression *end;
 
-    RangeExpression(Expression *start, Expression *end);
+    RangeExpression(Expression *start, Expression *end, Span span);
+};
+
+// arena_slice(arena, T, count) --> []T of count zeroed values in the arena
+struct ArenaSliceExpression : Expression {
+    Expression     *arena;
+    TypeExpression *type_expression;
+    Expression     *count;
+
+    ArenaSliceExpression(Expression *arena, TypeExpression *type_expression, Expression *count, Span span);
+};
+
+// embed "file.bin" --> [N]u8 of the bytes in the file
+// embed i32 "file.bin" --> [N]i32, the file size has to be a multiple of the number size
+// the file is put into the executable by the assembler and is read only
+struct EmbedExpression : Expression {
+    TokenIndex      path;
+    TypeExpression *element_type;  // NULL for u8
+    std::string     absolute_path; // the rest are set at type checking time
+    u64             byte_size;
+    u64             index;         // names the symbol the bytes are at, one per file and type in a compilation unit
+
+    EmbedExpression(TokenIndex path, TypeExpression *element_type, Span span);
 };
 
 /*
     ======= TYPE EXPRESSIONS ========
 */
-struct TypeExpression {
+struct TypeExpression : Node {
     Span                  span      = {};
     TypeInfo             *type_info = nullptr;
     TypeExpressionType    type;
@@ -501,6 +673,7 @@ struct TypeExpression {
 
 struct IdentifierTypeExpression : TypeExpression {
     TokenIndex identifier;
+    bool       is_generic_param; // set at type checking time, the type is one given to a generic fn instance
 
     IdentifierTypeExpression(TokenIndex identifier, Span span);
 };
@@ -531,3 +704,25 @@ struct SliceTypeExpression : TypeExpression {
 
     SliceTypeExpression(TypeExpression *base_type);
 };
+
+// Pool[T]
+struct PoolTypeExpression : TypeExpression {
+    TypeExpression *base_type;
+
+    PoolTypeExpression(TypeExpression *base_type, Span span);
+};
+
+// [dyn]T
+struct DynamicArrayTypeExpression : TypeExpression {
+    TypeExpression *base_type;
+
+    DynamicArrayTypeExpression(TypeExpression *base_type);
+};
+
+// HashMap[K, V]
+struct HashMapTypeExpression : TypeExpression {
+    TypeExpression *key_type;
+    TypeExpression *value_type;
+
+    HashMapTypeExpression(TypeExpression *key_type, TypeExpression *value_type, Span span);
+};
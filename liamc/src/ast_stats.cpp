@@ -0,0 +1,526 @@
+#include "ast_stats.h"
+
+#include "baseLayer/debug.h"
+
+template <typename T> u64 vector_bytes(const std::vector<T> &vector) {
+    return vector.capacity() * sizeof(T);
+}
+
+u64 statement_size(Statement *statement) {
+    switch (statement->statement_type) {
+    case StatementType::EXPRESSION:
+        return sizeof(ExpressionStatement);
+    case StatementType::LET:
+        return sizeof(LetStatement);
+    case StatementType::SCOPE:
+        return sizeof(ScopeStatement) + vector_bytes(static_cast<ScopeStatement *>(statement)->statements);
+    case StatementType::FN:
+        return sizeof(FnStatement) + vector_bytes(static_cast<FnStatement *>(statement)->params);
+    case StatementType::STRUCT:
+        return sizeof(StructStatement) + vector_bytes(static_cast<StructStatement *>(statement)->members);
+    case StatementType::ASSIGNMENT:
+        return sizeof(AssigmentStatement);
+    case StatementType::RETURN:
+        return sizeof(ReturnStatement);
+    case StatementType::BREAK:
+        return sizeof(BreakStatement);
+    case StatementType::FOR:
+        return sizeof(ForStatement);
+    case StatementType::IF:
+        return sizeof(IfStatement);
+    case StatementType::ELSE:
+        return sizeof(ElseStatement);
+    case StatementType::CONTINUE:
+        return sizeof(ContinueStatement);
+    case StatementType::IMPORT:
+        return sizeof(ImportStatement);
+    case StatementType::PRINT:
+        return sizeof(PrintStatement);
+    case StatementType::ASSERT:
+        return sizeof(AssertStatement);
+    case StatementType::WHILE:
+        return sizeof(WhileStatement);
+    default:
+        UNREACHABLE();
+    }
+
+    return 0;
+}
+
+u64 expression_size(Expression *expression) {
+    switch (expression->type) {
+    case ExpressionType::BINARY:
+        return sizeof(BinaryExpression);
+    case ExpressionType::UNARY:
+        return sizeof(UnaryExpression);
+    case ExpressionType::SUBSCRIPT:
+        return sizeof(SubscriptExpression);
+    case ExpressionType::NUMBER_LITERAL:
+        return sizeof(NumberLiteralExpression);
+    case ExpressionType::STRING_LITERAL:
+        return sizeof(StringLiteralExpression);
+    case ExpressionType::BOOL_LITERAL:
+        return sizeof(BoolLiteralExpression);
+    case ExpressionType::IDENTIFIER:
+        return sizeof(IdentifierExpression);
+    case ExpressionType::CALL:
+        return sizeof(CallExpression) + vector_bytes(static_cast<CallExpression *>(expression)->args);
+    case ExpressionType::GET:
+        return sizeof(GetExpression);
+    case ExpressionType::GROUP:
+        return sizeof(GroupExpression);
+    case ExpressionType::NULL_LITERAL:
+        return sizeof(NullLiteralExpression);
+    case ExpressionType::ZERO_LITERAL:
+        return sizeof(ZeroLiteralExpression);
+    case ExpressionType::INSTANTIATION:
+        return sizeof(InstantiateExpression);
+    case ExpressionType::STRUCT_INSTANCE:
+        return sizeof(StructInstanceExpression) +
+               vector_bytes(static_cast<StructInstanceExpression *>(expression)->named_expressions);
+    case ExpressionType::STATIC_ARRAY:
+        return sizeof(StaticArrayExpression) +
+               vector_bytes(static_cast<StaticArrayExpression *>(expression)->expressions);
+    case ExpressionType::RANGE:
+        return sizeof(RangeExpression);
+    case ExpressionType::ARENA_SLICE:
+        return sizeof(ArenaSliceExpression);
+    case ExpressionType::EMBED:
+        return sizeof(EmbedExpression);
+    default:
+        UNREACHABLE();
+    }
+
+    return 0;
+}
+
+u64 type_expression_size(TypeExpression *type_expression) {
+    switch (type_expression->type) {
+    case TypeExpressionType::TYPE_IDENTIFIER:
+        return sizeof(IdentifierTypeExpression);
+    case TypeExpressionType::TYPE_UNARY:
+        return sizeof(UnaryTypeExpression);
+    case TypeExpressionType::TYPE_GET:
+        return sizeof(GetTypeExpression);
+    case TypeExpressionType::TYPE_STATIC_ARRAY:
+        return sizeof(StaticArrayTypeExpression);
+    case TypeExpressionType::TYPE_SLICE:
+        return sizeof(SliceTypeExpression);
+    case TypeExpressionType::TYPE_POOL:
+        return sizeof(PoolTypeExpression);
+    case TypeExpressionType::TYPE_DYNAMIC_ARRAY:
+        return sizeof(DynamicArrayTypeExpression);
+    case TypeExpressionType::TYPE_HASH_MAP:
+        return sizeof(HashMapTypeExpression);
+    default:
+        UNREACHABLE();
+    }
+
+    return 0;
+}
+
+u64 type_info_size(TypeInfo *type_info) {
+    switch (type_info->type) {
+    case TypeInfoType::ANY:
+        return sizeof(AnyTypeInfo);
+    case TypeInfoType::VOID:
+        return sizeof(VoidTypeInfo);
+    case TypeInfoType::NUMBER:
+        return sizeof(NumberTypeInfo);
+    case TypeInfoType::BOOLEAN:
+        return sizeof(BoolTypeInfo);
+    case TypeInfoType::STRING:
+        return sizeof(StrTypeInfo);
+    case TypeInfoType::FN:
+        return sizeof(FnTypeInfo) + vector_bytes(((FnTypeInfo *)type_info)->args);
+    case TypeInfoType::STRUCT:
+        return sizeof(StructTypeInfo) + vector_bytes(((StructTypeInfo *)type_info)->members);
+    case TypeInfoType::POINTER:
+        return sizeof(PointerTypeInfo);
+    case TypeInfoType::NAMESPACE:
+        return sizeof(NamespaceTypeInfo);
+    case TypeInfoType::STATIC_ARRAY:
+        return sizeof(StaticArrayTypeInfo);
+    case TypeInfoType::SLICE:
+        return sizeof(SliceTypeInfo);
+    case TypeInfoType::RANGE:
+        return sizeof(RangeTypeInfo);
+    case TypeInfoType::VECTOR:
+        return sizeof(VectorTypeInfo);
+    case TypeInfoType::TYPE:
+        return sizeof(TypeTypeInfo);
+    case TypeInfoType::ARENA:
+        return sizeof(ArenaTypeInfo);
+    case TypeInfoType::POOL:
+        return sizeof(PoolTypeInfo);
+    case TypeInfoType::DYNAMIC_ARRAY:
+        return sizeof(DynamicArrayTypeInfo);
+    case TypeInfoType::HASH_MAP:
+        return sizeof(HashMapTypeInfo);
+    default:
+        UNREACHABLE();
+    }
+
+    return 0;
+}
+
+AstStats::AstStats() {
+    this->token_count            = 0;
+    this->token_bytes            = 0;
+    this->statement_counts       = std::unordered_map<StatementType, u64>();
+    this->statement_bytes        = std::unordered_map<StatementType, u64>();
+    this->expression_counts      = std::unordered_map<ExpressionType, u64>();
+    this->expression_bytes       = std::unordered_map<ExpressionType, u64>();
+    this->type_expression_counts = std::unordered_map<TypeExpressionType, u64>();
+    this->type_expression_bytes  = std::unordered_map<TypeExpressionType, u64>();
+    this->type_info_counts       = std::unordered_map<TypeInfoType, u64>();
+    this->type_info_bytes        = std::unordered_map<TypeInfoType, u64>();
+    this->scope_entry_count      = 0;
+    this->scope_bytes            = 0;
+    this->type_infos             = std::unordered_set<TypeInfo *>();
+}
+
+void AstStats::count_bundle(CompilationBundle *bundle) {
+    for (CompilationUnit *compilation_unit : bundle->compilation_units) {
+        count_compilation_unit(compilation_unit);
+    }
+}
+
+void AstStats::count_compilation_unit(CompilationUnit *compilation_unit) {
+    this->token_count += compilation_unit->token_buffer.size();
+    this->token_bytes += vector_bytes(compilation_unit->token_buffer);
+
+    for (auto stmt : compilation_unit->top_level_import_statements) {
+        count_statement(stmt);
+    }
+
+    for (auto stmt : compilation_unit->top_level_struct_statements) {
+        count_statement(stmt);
+    }
+
+    for (auto stmt : compilation_unit->top_level_fn_statements) {
+        count_statement(stmt);
+    }
+
+    // generic fn instances are parsed again by the type checker so have their own trees
+    for (auto stmt : compilation_unit->generic_fn_instances) {
+        count_statement(stmt);
+    }
+
+    // builtin types and any symbols the type checker has added
+    count_scope(&compilation_unit->global_type_scope);
+    count_scope(&compilation_unit->global_fn_scope);
+    count_scope(&compilation_unit->global_namespace_scope);
+}
+
+void AstStats::count_scope(Scope *scope) {
+    // each entry is a heap node holding the pair, the next pointer and the cached hash
+    this->scope_entry_count += scope->size();
+    this->scope_bytes += scope->bucket_count() * sizeof(void *);
+    this->scope_bytes += scope->size() * (sizeof(Scope::value_type) + sizeof(void *) + sizeof(size_t));
+
+    for (auto &[identifier, type_info] : *scope) {
+        // short strings are stored inside the string itself
+        if (identifier.capacity() > std::string().capacity()) {
+            this->scope_bytes += identifier.capacity() + 1;
+        }
+
+        count_type_info(type_info);
+    }
+}
+
+void AstStats::count_statement(Statement *statement) {
+    if (statement == NULL) {
+        return;
+    }
+
+    this->statement_counts[statement->statement_type]++;
+    this->statement_bytes[statement->statement_type] += statement_size(statement);
+
+    switch (statement->statement_type) {
+    case StatementType::EXPRESSION: {
+        count_expression(static_cast<ExpressionStatement *>(statement)->expression);
+    } break;
+    case StatementType::LET: {
+        auto let_statement = static_cast<LetStatement *>(statement);
+        count_expression(let_statement->rhs);
+        count_type_expression(let_statement->type);
+    } break;
+    case StatementType::SCOPE: {
+        for (auto stmt : static_cast<ScopeStatement *>(statement)->statements) {
+            count_statement(stmt);
+        }
+    } break;
+    case StatementType::FN: {
+        auto fn_statement = static_cast<FnStatement *>(statement);
+        for (auto &[_, type_expression] : fn_statement->params) {
+            count_type_expression(type_expression);
+        }
+        count_type_expression(fn_statement->return_type);
+        count_statement(fn_statement->body);
+    } break;
+    case StatementType::STRUCT: {
+        auto struct_statement = static_cast<StructStatement *>(statement);
+        for (auto &[_, type_expression] : struct_statement->members) {
+            count_type_expression(type_expression);
+        }
+        count_type_info(struct_statement->type_info);
+    } break;
+    case StatementType::ASSIGNMENT: {
+        auto assigment_statement = static_cast<AssigmentStatement *>(statement);
+        count_expression(assigment_statement->lhs);
+        count_statement(assigment_statement->assigned_to);
+    } break;
+    case StatementType::RETURN: {
+        count_expression(static_cast<ReturnStatement *>(statement)->expression);
+    } break;
+    case StatementType::FOR: {
+        auto for_statement = static_cast<ForStatement *>(statement);
+        count_expression(for_statement->expression);
+        count_expression(for_statement->grain);
+        count_statement(for_statement->body);
+    } break;
+    case StatementType::IF: {
+        auto if_statement = static_cast<IfStatement *>(statement);
+        count_expression(if_statement->expression);
+        count_statement(if_statement->body);
+        count_statement(if_statement->else_statement);
+    } break;
+    case StatementType::ELSE: {
+        auto else_statement = static_cast<ElseStatement *>(statement);
+        count_statement(else_statement->if_statement);
+        count_statement(else_statement->body);
+    } break;
+    case StatementType::IMPORT: {
+        count_type_info(static_cast<ImportStatement *>(statement)->namespace_type_info);
+    } break;
+    case StatementType::PRINT: {
+        count_expression(static_cast<PrintStatement *>(statement)->expression);
+    } break;
+    case StatementType::ASSERT: {
+        count_expression(static_cast<AssertStatement *>(statement)->expression);
+    } break;
+    case StatementType::WHILE: {
+        auto while_statement = static_cast<WhileStatement *>(statement);
+        count_expression(while_statement->expression);
+        count_statement(while_statement->body);
+    } break;
+    case StatementType::BREAK:
+    case StatementType::CONTINUE:
+        break;
+    default:
+        UNREACHABLE();
+    }
+}
+
+void AstStats::count_expression(Expression *expression) {
+    if (expression == NULL) {
+        return;
+    }
+
+    this->expression_counts[expression->type]++;
+    this->expression_bytes[expression->type] += expression_size(expression);
+    count_type_info(expression->type_info);
+
+    switch (expression->type) {
+    case ExpressionType::BINARY: {
+        auto binary_expression = static_cast<BinaryExpression *>(expression);
+        count_expression(binary_expression->left);
+        count_expression(binary_expression->right);
+    } break;
+    case ExpressionType::UNARY: {
+        count_expression(static_cast<UnaryExpression *>(expression)->expression);
+    } break;
+    case ExpressionType::SUBSCRIPT: {
+        auto subscript_expression = static_cast<SubscriptExpression *>(expression);
+        count_expression(subscript_expression->subscriptee);
+        count_expression(subscript_expression->subscripter);
+    } break;
+    case ExpressionType::CALL: {
+        auto call_expression = static_cast<CallExpression *>(expression);
+        count_expression(call_expression->callee);
+        for (auto arg : call_expression->args) {
+            count_expression(arg);
+        }
+    } break;
+    case ExpressionType::GET: {
+        count_expression(static_cast<GetExpression *>(expression)->lhs);
+    } break;
+    case ExpressionType::GROUP: {
+        count_expression(static_cast<GroupExpression *>(expression)->sub_expression);
+    } break;
+    case ExpressionType::INSTANTIATION: {
+        count_expression(static_cast<InstantiateExpression *>(expression)->expression);
+    } break;
+    case ExpressionType::STRUCT_INSTANCE: {
+        auto struct_instance_expression = static_cast<StructInstanceExpression *>(expression);
+        count_type_expression(struct_instance_expression->type_expression);
+        for (auto &[_, expr] : struct_instance_expression->named_expressions) {
+            count_expression(expr);
+        }
+        count_expression(struct_instance_expression->allocator);
+    } break;
+    case ExpressionType::STATIC_ARRAY: {
+        auto static_array_expression = static_cast<StaticArrayExpression *>(expression);
+        count_expression(static_array_expression->number);
+        count_type_expression(static_array_expression->type_expression);
+        for (auto expr : static_array_expression->expressions) {
+            count_expression(expr);
+        }
+    } break;
+    case ExpressionType::RANGE: {
+        auto range_expression = static_cast<RangeExpression *>(expression);
+        count_expression(range_expression->start);
+        count_expression(range_expression->end);
+    } break;
+    case ExpressionType::ARENA_SLICE: {
+        auto arena_slice_expression = static_cast<ArenaSliceExpression *>(expression);
+        count_expression(arena_slice_expression->arena);
+        count_type_expression(arena_slice_expression->type_expression);
+        count_expression(arena_slice_expression->count);
+    } break;
+    case ExpressionType::EMBED:
+        count_type_expression(static_cast<EmbedExpression *>(expression)->element_type);
+        break;
+    case ExpressionType::NUMBER_LITERAL:
+    case ExpressionType::STRING_LITERAL:
+    case ExpressionType::BOOL_LITERAL:
+    case ExpressionType::IDENTIFIER:
+    case ExpressionType::NULL_LITERAL:
+    case ExpressionType::ZERO_LITERAL:
+        break;
+    default:
+        UNREACHABLE();
+    }
+}
+
+void AstStats::count_type_expression(TypeExpression *type_expression) {
+    if (type_expression == NULL) {
+        return;
+    }
+
+    this->type_expression_counts[type_expression->type]++;
+    this->type_expression_bytes[type_expression->type] += type_expression_size(type_expression);
+    count_type_info(type_expression->type_info);
+
+    switch (type_expression->type) {
+    case TypeExpressionType::TYPE_UNARY: {
+        count_type_expression(static_cast<UnaryTypeExpression *>(type_expression)->type_expression);
+    } break;
+    case TypeExpressionType::TYPE_GET: {
+        count_type_expression(static_cast<GetTypeExpression *>(type_expression)->type_expression);
+    } break;
+    case TypeExpressionType::TYPE_STATIC_ARRAY: {
+        auto static_array_type_expression = static_cast<StaticArrayTypeExpression *>(type_expression);
+        count_expression(static_array_type_expression->size);
+        count_type_expression(static_array_type_expression->base_type);
+    } break;
+    case TypeExpressionType::TYPE_SLICE: {
+        count_type_expression(static_cast<SliceTypeExpression *>(type_expression)->base_type);
+    } break;
+    case TypeExpressionType::TYPE_POOL: {
+        count_type_expression(static_cast<PoolTypeExpression *>(type_expression)->base_type);
+    } break;
+    case TypeExpressionType::TYPE_DYNAMIC_ARRAY: {
+        count_type_expression(static_cast<DynamicArrayTypeExpression *>(type_expression)->base_type);
+    } break;
+    case TypeExpressionType::TYPE_HASH_MAP: {
+        auto hash_map_type_expression = static_cast<HashMapTypeExpression *>(type_expression);
+        count_type_expression(hash_map_type_expression->key_type);
+        count_type_expression(hash_map_type_expression->value_type);
+    } break;
+    case TypeExpressionType::TYPE_IDENTIFIER:
+        break;
+    default:
+        UNREACHABLE();
+    }
+}
+
+void AstStats::count_type_info(TypeInfo *type_info) {
+    // already seen types are skipped, this also stops recursive
+    // types from looping forever e.g. struct Node { next: ^Node }
+    if (type_info == NULL || this->type_infos.count(type_info) > 0) {
+        return;
+    }
+
+    this->type_infos.insert(type_info);
+    this->type_info_counts[type_info->type]++;
+    this->type_info_bytes[type_info->type] += type_info_size(type_info);
+
+    switch (type_info->type) {
+    case TypeInfoType::POINTER: {
+        count_type_info(((PointerTypeInfo *)type_info)->to);
+    } break;
+    case TypeInfoType::STRUCT: {
+        for (auto &[_, member_type_info] : ((StructTypeInfo *)type_info)->members) {
+            count_type_info(member_type_info);
+        }
+    } break;
+    case TypeInfoType::FN: {
+        FnTypeInfo *fn_type_info = (FnTypeInfo *)type_info;
+        count_type_info(fn_type_info->return_type);
+        for (TypeInfo *arg : fn_type_info->args) {
+            count_type_info(arg);
+        }
+    } break;
+    case TypeInfoType::STATIC_ARRAY: {
+        count_type_info(((StaticArrayTypeInfo *)type_info)->base_type);
+    } break;
+    case TypeInfoType::SLICE: {
+        count_type_info(((SliceTypeInfo *)type_info)->base_type);
+    } break;
+    case TypeInfoType::VECTOR: {
+        count_type_info(((VectorTypeInfo *)type_info)->base_type);
+    } break;
+    case TypeInfoType::TYPE: {
+        count_type_info(((TypeTypeInfo *)type_info)->of);
+    } break;
+    case TypeInfoType::POOL: {
+        count_type_info(((PoolTypeInfo *)type_info)->base_type);
+    } break;
+    case TypeInfoType::DYNAMIC_ARRAY: {
+        count_type_info(((DynamicArrayTypeInfo *)type_info)->base_type);
+    } break;
+    case TypeInfoType::HASH_MAP: {
+        count_type_info(((HashMapTypeInfo *)type_info)->entry_type);
+    } break;
+    default:
+        break;
+    }
+}
+
+u64 AstStats::ast_node_count() {
+    u64 count = 0;
+
+    for (auto &[_, n] : this->statement_counts) {
+        count += n;
+    }
+
+    for (auto &[_, n] : this->expression_counts) {
+        count += n;
+    }
+
+    for (auto &[_, n] : this->type_expression_counts) {
+        count += n;
+    }
+
+    return count;
+}
+
+u64 AstStats::ast_node_bytes() {
+    u64 bytes = 0;
+
+    for (auto &[_, n] : this->statement_bytes) {
+        bytes += n;
+    }
+
+    for (auto &[_, n] : this->expression_bytes) {
+        bytes += n;
+    }
+
+    for (auto &[_, n] : this->type_expression_bytes) {
+        bytes += n;
+    }
+
+    return bytes;
+}
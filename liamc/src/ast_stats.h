@@ -0,0 +1,43 @@
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ast.h"
+#include "compilation_unit.h"
+
+// Walks the ast of a bundle and counts what is in it, this is only
+// done when asked for by --trace or --mem-stats so it is kept out of the
+// parser and type checker to not slow them down when it is not needed.
+// Bytes are the size of each node plus the buffers of the vectors it owns,
+// strings and allocator overhead are not followed so they are a lower bound
+struct AstStats {
+    u64                                         token_count;
+    u64                                         token_bytes;
+    std::unordered_map<StatementType, u64>      statement_counts;
+    std::unordered_map<StatementType, u64>      statement_bytes;
+    std::unordered_map<ExpressionType, u64>     expression_counts;
+    std::unordered_map<ExpressionType, u64>     expression_bytes;
+    std::unordered_map<TypeExpressionType, u64> type_expression_counts;
+    std::unordered_map<TypeExpressionType, u64> type_expression_bytes;
+    std::unordered_map<TypeInfoType, u64>       type_info_counts;
+    std::unordered_map<TypeInfoType, u64>       type_info_bytes;
+    u64                                         scope_entry_count;
+    u64                                         scope_bytes;
+
+    // type infos are shared between nodes so only unique ones are counted
+    std::unordered_set<TypeInfo *> type_infos;
+
+    AstStats();
+
+    void count_bundle(CompilationBundle *bundle);
+    void count_compilation_unit(CompilationUnit *compilation_unit);
+    void count_statement(Statement *statement);
+    void count_expression(Expression *expression);
+    void count_type_expression(TypeExpression *type_expression);
+    void count_type_info(TypeInfo *type_info);
+    void count_scope(Scope *scope);
+
+    u64 ast_node_count();
+    u64 ast_node_bytes();
+};
@@ -0,0 +1,290 @@
+#include "bounds_analysis.h"
+
+#include "baseLayer/debug.h"
+#include "mutation_analysis.h"
+
+// the value of a number literal if it is not negative
+static bool non_negative_literal(Expression *expression, u64 *value) {
+    if (expression == NULL || expression->type != ExpressionType::NUMBER_LITERAL) {
+        return false;
+    }
+
+    auto number_literal   = static_cast<NumberLiteralExpression *>(expression);
+    auto number_type_info = static_cast<NumberTypeInfo *>(number_literal->type_info);
+    if (number_type_info->number_type == NumberType::UNSIGNED) {
+        *value = number_literal->value.u;
+        return true;
+    }
+
+    if (number_type_info->number_type == NumberType::SIGNED && number_literal->value.i >= 0) {
+        *value = (u64)number_literal->value.i;
+        return true;
+    }
+
+    return false;
+}
+
+BoundsAnalysis::BoundsAnalysis(CompilationUnit *compilation_unit) {
+    this->compilation_unit = compilation_unit;
+    this->bounds           = std::vector<IndexBound>();
+}
+
+void BoundsAnalysis::analyse_statement(Statement *statement) {
+    if (statement == NULL) {
+        return;
+    }
+
+    switch (statement->statement_type) {
+    case StatementType::EXPRESSION:
+        analyse_expression(static_cast<ExpressionStatement *>(statement)->expression);
+        break;
+    case StatementType::LET: {
+        auto let_statement = static_cast<LetStatement *>(statement);
+        analyse_expression(let_statement->rhs);
+        forget(this->compilation_unit->get_token_string_from_index(let_statement->identifier));
+    } break;
+    case StatementType::SCOPE: {
+        for (auto stmt : static_cast<ScopeStatement *>(statement)->statements) {
+            analyse_statement(stmt);
+        }
+    } break;
+    case StatementType::ASSIGNMENT: {
+        auto assigment_statement = static_cast<AssigmentStatement *>(statement);
+        analyse_expression(assigment_statement->lhs);
+        analyse_statement(assigment_statement->assigned_to);
+    } break;
+    case StatementType::RETURN:
+        analyse_expression(static_cast<ReturnStatement *>(statement)->expression);
+        break;
+    case StatementType::FOR:
+        analyse_for_statement(static_cast<ForStatement *>(statement));
+        break;
+    case StatementType::IF: {
+        auto if_statement = static_cast<IfStatement *>(statement);
+        analyse_expression(if_statement->expression);
+        analyse_statement(if_statement->body);
+        analyse_statement(if_statement->else_statement);
+    } break;
+    case StatementType::ELSE: {
+        auto else_statement = static_cast<ElseStatement *>(statement);
+        analyse_statement(else_statement->if_statement);
+        analyse_statement(else_statement->body);
+    } break;
+    case StatementType::PRINT:
+        analyse_expression(static_cast<PrintStatement *>(statement)->expression);
+        break;
+    case StatementType::ASSERT:
+        analyse_expression(static_cast<AssertStatement *>(statement)->expression);
+        break;
+    case StatementType::WHILE: {
+        auto while_statement = static_cast<WhileStatement *>(statement);
+        analyse_expression(while_statement->expression);
+        analyse_statement(while_statement->body);
+    } break;
+    default:
+        // anything not handled here keeps its subscripts checked
+        break;
+    }
+}
+
+void BoundsAnalysis::analyse_for_statement(ForStatement *statement) {
+    analyse_expression(statement->expression);
+    analyse_expression(statement->grain);
+
+    std::string identifier = this->compilation_unit->get_token_string_from_index(statement->value_identifier);
+    forget(identifier);
+
+    if (statement->for_type != ForType::RANGE) {
+        analyse_statement(statement->body);
+        return;
+    }
+
+    // for i : {start:end}
+    // start has to be a literal >= 0 and end has to be a literal, the size of a
+    // static array or vector (which is known from its type) or the size of a slice
+    auto       range_expression = static_cast<RangeExpression *>(statement->expression);
+    IndexBound bound            = IndexBound{identifier, false, 0, "", true};
+    bool       bounded          = false;
+    u64        start            = 0;
+
+    if (non_negative_literal(range_expression->start, &start) && range_expression->end != NULL) {
+        Expression *end = range_expression->end;
+        if (non_negative_literal(end, &bound.size)) {
+            bound.constant_size = true;
+            bounded             = true;
+        } else if (end->type == ExpressionType::GET && is_size_member(static_cast<GetExpression *>(end))) {
+            Expression *sized = static_cast<GetExpression *>(end)->lhs;
+            if (sized->type_info->type == TypeInfoType::STATIC_ARRAY) {
+                bound.constant_size = true;
+                bound.size          = static_cast<StaticArrayTypeInfo *>(sized->type_info)->size;
+                bounded             = true;
+            } else if (sized->type_info->type == TypeInfoType::VECTOR) {
+                bound.constant_size = true;
+                bound.size          = static_cast<VectorTypeInfo *>(sized->type_info)->lanes;
+                bounded             = true;
+            } else if (sized->type_info->type == TypeInfoType::SLICE && sized->type == ExpressionType::IDENTIFIER) {
+                auto slice_identifier = static_cast<IdentifierExpression *>(sized)->identifier;
+                bound.size_of         = this->compilation_unit->get_token_string_from_index(slice_identifier);
+                bounded               = true;
+            }
+        }
+    }
+
+    // the range is only checked once at the start so the body can not change
+    // the identifier or the slice the range ends at
+    if (bounded) {
+        std::vector<std::string> watched = {identifier};
+        if (!bound.constant_size) {
+            watched.push_back(bound.size_of);
+        }
+
+        MutationAnalysis mutation_analysis      = MutationAnalysis(this->compilation_unit, watched);
+        mutation_analysis.ignore_element_writes = true;
+        bounded                                 = !mutation_analysis.might_mutate_statement(statement->body);
+    }
+
+    if (!bounded) {
+        analyse_statement(statement->body);
+        return;
+    }
+
+    this->bounds.push_back(bound);
+    analyse_statement(statement->body);
+    this->bounds.pop_back();
+}
+
+void BoundsAnalysis::analyse_expression(Expression *expression) {
+    if (expression == NULL) {
+        return;
+    }
+
+    switch (expression->type) {
+    case ExpressionType::BINARY: {
+        auto binary_expression = static_cast<BinaryExpression *>(expression);
+        analyse_expression(binary_expression->left);
+        analyse_expression(binary_expression->right);
+    } break;
+    case ExpressionType::UNARY:
+        analyse_expression(static_cast<UnaryExpression *>(expression)->expression);
+        break;
+    case ExpressionType::SUBSCRIPT: {
+        auto subscript_expression = static_cast<SubscriptExpression *>(expression);
+        analyse_expression(subscript_expression->subscriptee);
+        analyse_expression(subscript_expression->subscripter);
+        subscript_expression->in_bounds = is_in_bounds(subscript_expression);
+    } break;
+    case ExpressionType::CALL: {
+        auto call_expression = static_cast<CallExpression *>(expression);
+        analyse_expression(call_expression->callee);
+        for (auto arg : call_expression->args) {
+            analyse_expression(arg);
+        }
+    } break;
+    case ExpressionType::GET:
+        analyse_expression(static_cast<GetExpression *>(expression)->lhs);
+        break;
+    case ExpressionType::GROUP:
+        analyse_expression(static_cast<GroupExpression *>(expression)->sub_expression);
+        break;
+    case ExpressionType::INSTANTIATION:
+        analyse_expression(static_cast<InstantiateExpression *>(expression)->expression);
+        break;
+    case ExpressionType::STRUCT_INSTANCE: {
+        auto struct_instance_expression = static_cast<StructInstanceExpression *>(expression);
+        for (auto &[_, expr] : struct_instance_expression->named_expressions) {
+            analyse_expression(expr);
+        }
+        analyse_expression(struct_instance_expression->allocator);
+    } break;
+    case ExpressionType::STATIC_ARRAY: {
+        for (auto expr : static_cast<StaticArrayExpression *>(expression)->expressions) {
+            analyse_expression(expr);
+        }
+    } break;
+    case ExpressionType::RANGE: {
+        auto range_expression = static_cast<RangeExpression *>(expression);
+        analyse_expression(range_expression->start);
+        analyse_expression(range_expression->end);
+    } break;
+    case ExpressionType::ARENA_SLICE: {
+        auto arena_slice_expression = static_cast<ArenaSliceExpression *>(expression);
+        analyse_expression(arena_slice_expression->arena);
+        analyse_expression(arena_slice_expression->count);
+    } break;
+    default:
+        break;
+    }
+}
+
+bool BoundsAnalysis::is_in_bounds(SubscriptExpression *expression) {
+    Expression *subscriptee = expression->subscriptee;
+    Expression *subscripter = expression->subscripter;
+
+    // ranges make slices which are not bounds checked
+    if (subscripter->type == ExpressionType::RANGE) {
+        return false;
+    }
+
+    // vectors have a constant number of lanes so are the same as static arrays here
+    bool is_static_array = subscriptee->type_info->type == TypeInfoType::STATIC_ARRAY ||
+                           subscriptee->type_info->type == TypeInfoType::VECTOR;
+    u64  array_size      = 0;
+    if (subscriptee->type_info->type == TypeInfoType::STATIC_ARRAY) {
+        array_size = static_cast<StaticArrayTypeInfo *>(subscriptee->type_info)->size;
+    } else if (subscriptee->type_info->type == TypeInfoType::VECTOR) {
+        array_size = static_cast<VectorTypeInfo *>(subscriptee->type_info)->lanes;
+    }
+
+    // arr[2]
+    u64 index = 0;
+    if (non_negative_literal(subscripter, &index)) {
+        return is_static_array && index < array_size;
+    }
+
+    // arr[i] or s[i]
+    if (subscripter->type != ExpressionType::IDENTIFIER) {
+        return false;
+    }
+
+    auto        index_identifier = static_cast<IdentifierExpression *>(subscripter);
+    std::string identifier       = this->compilation_unit->get_token_string_from_index(index_identifier->identifier);
+
+    // the innermost loop with this identifier is the one in scope
+    for (i64 i = this->bounds.size() - 1; i >= 0; i--) {
+        IndexBound &bound = this->bounds[i];
+        if (bound.identifier != identifier) {
+            continue;
+        }
+
+        if (!bound.valid) {
+            return false;
+        }
+
+        if (bound.constant_size) {
+            return is_static_array && bound.size <= array_size;
+        }
+
+        if (subscriptee->type != ExpressionType::IDENTIFIER) {
+            return false;
+        }
+
+        auto slice_identifier = static_cast<IdentifierExpression *>(subscriptee);
+        return this->compilation_unit->get_token_string_from_index(slice_identifier->identifier) == bound.size_of;
+    }
+
+    return false;
+}
+
+bool BoundsAnalysis::is_size_member(GetExpression *expression) {
+    return this->compilation_unit->get_token_string_from_index(expression->member) == "size";
+}
+
+void BoundsAnalysis::forget(std::string identifier) {
+    // once shadowed the identifier is not the one the bound was made for, it
+    // stays forgotten until the loop ends as we do not track scopes here
+    for (auto &bound : this->bounds) {
+        if (bound.identifier == identifier || bound.size_of == identifier) {
+            bound.valid = false;
+        }
+    }
+}
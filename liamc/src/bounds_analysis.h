@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ast.h"
+#include "compilation_unit.h"
+
+// what is known about the value of a range for loop identifier i.e.
+// for i : {0:array.size} --> i is always in [0, array.size)
+struct IndexBound {
+    std::string identifier;
+    bool        constant_size; // {0:4} or {0:static_array.size}
+    u64         size;          // set if constant_size
+    std::string size_of;       // the slice the range ends at if not constant_size
+    bool        valid;         // false once something shadows identifier or size_of
+};
+
+// Marks subscripts that can never be out of bounds so debug builds can skip
+// checking them. It only proves the simple cases:
+//      number literals into static arrays, arr[2] where arr is [4]T
+//      range for loop identifiers starting at a non negative literal and ending
+//      at a literal or the size of what they subscript, {0:s.size} then s[i]
+// and the loop identifier and slice can not be assigned in the body
+struct BoundsAnalysis {
+    CompilationUnit        *compilation_unit;
+    std::vector<IndexBound> bounds;
+
+    BoundsAnalysis(CompilationUnit *compilation_unit);
+
+    void analyse_statement(Statement *statement);
+    void analyse_for_statement(ForStatement *statement);
+    void analyse_expression(Expression *expression);
+    bool is_in_bounds(SubscriptExpression *expression);
+    bool is_size_member(GetExpression *expression);
+    void forget(std::string identifier);
+};
@@ -6,12 +6,16 @@
 #include "ast.h"
 #include "utils.h"
 
+#include <format>
+
 CompilationUnit::CompilationUnit(FileData *file_data, std::vector<Token> token_buffer) {
     this->file_data                   = file_data;
     this->token_buffer                = std::move(token_buffer);
     this->top_level_struct_statements = std::vector<StructStatement *>();
     this->top_level_fn_statements     = std::vector<FnStatement *>();
     this->top_level_import_statements = std::vector<ImportStatement *>();
+    this->embed_expressions           = std::vector<EmbedExpression *>();
+    this->generic_fn_instances        = std::vector<FnStatement *>();
     this->global_namespace_scope      = Scope();
     this->global_type_scope           = Scope();
     this->global_fn_scope             = Scope();
@@ -28,6 +32,30 @@ CompilationUnit::CompilationUnit(FileData *file_data, std::vector<Token> token_b
     this->global_type_scope["u64"]    = new NumberTypeInfo(NumberSize::SIZE_64, NumberType::UNSIGNED);
     this->global_type_scope["i64"]    = new NumberTypeInfo(NumberSize::SIZE_64, NumberType::SIGNED);
     this->global_type_scope["f64"]    = new NumberTypeInfo(NumberSize::SIZE_64, NumberType::FLOAT);
+    this->global_type_scope["Arena"]  = new ArenaTypeInfo();
+
+    // simd vectors, every 128 and 256 bit vector of these number types. The
+    // signed ones are also the masks comparing vectors gives
+    for (std::string base : {"i8", "u8", "i16", "i32", "f32", "i64", "f64"}) {
+        NumberTypeInfo *base_type  = (NumberTypeInfo *)this->global_type_scope[base];
+        u64             base_bytes = number_size_bytes(base_type->size);
+        for (u64 vector_bytes : {16, 32}) {
+            u64 lanes = vector_bytes / base_bytes;
+            this->global_type_scope[std::format("{}x{}", base, lanes)] = new VectorTypeInfo(base_type, lanes);
+        }
+    }
+
+    // builtin fns, these are in core.h. Files are mapped into memory and used as a []u8
+    TypeInfo *void_type_info  = this->global_type_scope["void"];
+    TypeInfo *bytes_type_info = new SliceTypeInfo(this->global_type_scope["u8"]);
+    this->global_fn_scope["map_file"]          = new FnTypeInfo(bytes_type_info, {bytes_type_info});
+    this->global_fn_scope["map_file_rw"]       = new FnTypeInfo(bytes_type_info, {bytes_type_info});
+    this->global_fn_scope["unmap_file"]        = new FnTypeInfo(void_type_info, {bytes_type_info});
+    this->global_fn_scope["advise_sequential"] = new FnTypeInfo(void_type_info, {bytes_type_info});
+    this->global_fn_scope["advise_random"]     = new FnTypeInfo(void_type_info, {bytes_type_info});
+    for (auto &[_, fn_type_info] : this->global_fn_scope) {
+        ((FnTypeInfo *)fn_type_info)->is_builtin = true;
+    }
 }
 
 Token *CompilationUnit::get_token(TokenIndex token_index) {
@@ -121,6 +149,13 @@ CompilationBundle::CompilationBundle(std::vector<CompilationUnit *> compilation_
     this->sorted_types      = std::vector<SortingNode>();
 }
 
+// the nodes in each unit belong to the node pool they were made in, the units only own their tokens
+CompilationBundle::~CompilationBundle() {
+    for (auto compilation_unit : this->compilation_units) {
+        delete compilation_unit;
+    }
+}
+
 Option<u64> CompilationBundle::get_compilation_unit_index_with_path_relative_from(std::string relative_from,
                                                                                   std::string path) {
     std::filesystem::path relative_slash_path = std::filesystem::path(relative_from) / path;
@@ -23,6 +23,8 @@ struct CompilationUnit {
     std::vector<StructStatement *> top_level_struct_statements;
     std::vector<FnStatement *>     top_level_fn_statements;
     std::vector<ImportStatement *> top_level_import_statements;
+    std::vector<EmbedExpression *> embed_expressions; // added when type checked, their bytes go at the top
+    std::vector<FnStatement *>     generic_fn_instances; // made when type checking calls to generic fns
 
     Scope global_namespace_scope;
     Scope global_type_scope;
@@ -49,6 +51,10 @@ struct CompilationBundle {
     FnStatement                   *entry_point;
 
     CompilationBundle(std::vector<CompilationUnit *> compilation_units);
+    ~CompilationBundle();
+
+    CompilationBundle(const CompilationBundle &)            = delete;
+    CompilationBundle &operator=(const CompilationBundle &) = delete;
 
     Option<u64> get_compilation_unit_index_with_path_relative_from(std::string relative_from, std::string path);
 };
@@ -0,0 +1,184 @@
+#include "compiler.h"
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <vector>
+
+#include "ast_stats.h"
+#include "cpp_backend.h"
+#include "lexer.h"
+#include "mem_stats.h"
+#include "parser.h"
+#include "type_checker.h"
+
+Compiler::Compiler(Arguments *arguments) {
+    this->arguments      = arguments;
+    this->error_reporter = ErrorReporter();
+    this->tracer         = Tracer();
+    this->tracer.enabled = !arguments->trace_path.empty();
+    this->bundle         = NULL;
+}
+
+Compiler::~Compiler() {
+    this->free_bundle();
+}
+
+void Compiler::free_bundle() {
+    delete this->bundle;
+    this->bundle = NULL;
+    this->node_pool.free_nodes();
+}
+
+Option<std::string> Compiler::compile() {
+    TraceSpan compile_span = TraceSpan(this->active_tracer(), "compile", "compiler");
+
+    TIME_START(lex_parse_time);
+    CompilationBundle *bundle = this->lex_parse();
+    TIME_END(lex_parse_time, "Lex and parsing time", this->arguments->time);
+
+    if (bundle == NULL) {
+        return Option<std::string>();
+    }
+
+    this->phase_stats("lex and parse", bundle, 0);
+
+    TIME_START(type_time);
+    bool type_check_passed = this->type_check(bundle);
+    TIME_END(type_time, "Type checking time", this->arguments->time);
+
+    if (!type_check_passed) {
+        return Option<std::string>();
+    }
+
+    this->phase_stats("type check", bundle, 0);
+
+    TIME_START(code_gen_time);
+    std::string code = this->code_gen(bundle);
+    TIME_END(code_gen_time, "Code generation time", this->arguments->time);
+
+    this->phase_stats("code gen", bundle, code.capacity());
+
+    // nothing is left pointing into the ast once the code is made so a build
+    // service compiling many projects with one compiler does not keep them all
+    this->free_bundle();
+
+    return Option(code);
+}
+
+CompilationBundle *Compiler::lex_parse() {
+    // anything left from the last compile goes before any new nodes are made
+    this->free_bundle();
+
+    TraceSpan                      phase_span  = TraceSpan(this->active_tracer(), "lex and parse", "phase");
+    ActiveNodePool                 active_pool = ActiveNodePool(&this->node_pool);
+    std::vector<CompilationUnit *> compilation_units;
+    u64                            token_count = 0;
+
+    for (auto &input_file : this->arguments->files) {
+        std::filesystem::path file_path = std::filesystem::path(input_file);
+        Option<FileData *>    file_data = this->file_manager.load_relative_from_cwd(file_path.string());
+
+        if (!file_data.is_some()) {
+            this->error_reporter.report_parser_error(
+                input_file, Span{}, std::format("cannot find input file '{}'", file_path.string()));
+            continue;
+        }
+
+        CompilationUnit *compilation_unit = NULL;
+        {
+            TraceSpan lex_span = TraceSpan(this->active_tracer(), input_file, "lex");
+            Lexer     lexer    = Lexer(file_data.value());
+            compilation_unit   = lexer.lex();
+            token_count += compilation_unit->token_buffer.size();
+        }
+
+        {
+            TraceSpan parse_span = TraceSpan(this->active_tracer(), input_file, "parse");
+            Parser    parser     = Parser(compilation_unit, &this->error_reporter);
+            parser.parse();
+            compilation_units.push_back(parser.compilation_unit);
+        }
+    }
+
+    this->tracer.counter("tokens", token_count);
+
+    this->bundle = new CompilationBundle(compilation_units);
+
+    if (this->error_reporter.has_parse_errors()) {
+        return NULL;
+    }
+
+    return this->bundle;
+}
+
+bool Compiler::type_check(CompilationBundle *bundle) {
+    TraceSpan      phase_span   = TraceSpan(this->active_tracer(), "type check", "phase");
+    ActiveNodePool active_pool  = ActiveNodePool(&this->node_pool);
+    TypeChecker    type_checker = TypeChecker(&this->error_reporter);
+    type_checker.tracer         = this->active_tracer();
+    type_checker.type_check(bundle);
+
+    return !this->error_reporter.has_type_check_errors();
+}
+
+std::string Compiler::code_gen(CompilationBundle *bundle) {
+    TraceSpan      phase_span  = TraceSpan(this->active_tracer(), "code gen", "phase");
+    ActiveNodePool active_pool = ActiveNodePool(&this->node_pool);
+    CppBackend     backend     = CppBackend();
+    backend.tracer             = this->active_tracer();
+    backend.profile            = this->arguments->profile;
+    return backend.emit(bundle);
+}
+
+void Compiler::print_errors() {
+    for (auto &error : this->error_reporter.parse_errors) {
+        error.print_error_message(&this->file_manager);
+    }
+
+    for (auto &error : this->error_reporter.type_check_errors) {
+        error.print_error_message(&this->file_manager);
+    }
+}
+
+u64 Compiler::total_line_count() {
+    u64 total_line_count = 0;
+    for (auto &file_data : *this->file_manager.get_files()) {
+        total_line_count += file_data->line_count;
+    }
+
+    return total_line_count;
+}
+
+void Compiler::phase_stats(std::string phase, CompilationBundle *bundle, u64 builder_bytes) {
+    // walking the whole ast is not free so only do it when someone is going to look
+    if (!this->tracer.enabled && !this->arguments->mem_stats) {
+        return;
+    }
+
+    AstStats stats = AstStats();
+    stats.count_bundle(bundle);
+
+    this->tracer.counter("ast nodes", stats.ast_node_count());
+    this->tracer.counter("types", stats.type_infos.size());
+
+    if (this->arguments->mem_stats) {
+        print_mem_stats(phase, &stats, builder_bytes);
+    }
+}
+
+Tracer *Compiler::active_tracer() {
+    if (!this->tracer.enabled) {
+        return NULL;
+    }
+
+    return &this->tracer;
+}
+
+bool Compiler::write_trace() {
+    if (!this->tracer.enabled) {
+        return true;
+    }
+
+    return this->tracer.write_to_file(this->arguments->trace_path);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+
+#include "args.h"
+#include "compilation_unit.h"
+#include "errors.h"
+#include "file.h"
+#include "liam.h"
+#include "trace.h"
+
+// Everything a single compilation needs lives in here, the files that have been
+// loaded, the errors that have been reported and the options it was started with.
+// Nothing is shared between two compilers so as many as needed can be run in the
+// same process, even at the same time on different threads
+struct Compiler {
+    Arguments    *arguments;
+    FileManager   file_manager;
+    ErrorReporter error_reporter;
+    Tracer        tracer;
+
+    // every node made by the phases goes in the node pool, both it and the bundle are
+    // kept until the next compile or the compiler is destroyed as errors point into them
+    NodePool           node_pool;
+    CompilationBundle *bundle;
+
+    Compiler(Arguments *arguments);
+    ~Compiler();
+
+    Compiler(const Compiler &)            = delete;
+    Compiler &operator=(const Compiler &) = delete;
+
+    // runs every phase and returns the generated c++, if any phase
+    // reports errors nothing is returned and the errors are left in
+    // the error reporter to be printed by the caller
+    Option<std::string> compile();
+
+    // frees the bundle and every node in the node pool, anything pointing into them
+    // like the errors from the last compile cannot be used after this
+    void free_bundle();
+
+    CompilationBundle *lex_parse();
+    bool               type_check(CompilationBundle *bundle);
+    std::string        code_gen(CompilationBundle *bundle);
+
+    void print_errors();
+    u64  total_line_count();
+
+    // counts what is in the ast after each phase for --trace and --mem-stats
+    void phase_stats(std::string phase, CompilationBundle *bundle, u64 builder_bytes);
+
+    // the tracer if --trace was given otherwise NULL, phases are handed
+    // this so they can skip building span names when nothing is recorded
+    Tracer *active_tracer();
+    bool    write_trace();
+};
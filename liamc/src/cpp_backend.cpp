@@ -1,6 +1,7 @@
 #include "cpp_backend.h"
 
 #include <algorithm>
+#include <charconv>
 #include <cstddef>
 #include <format>
 #include <ranges>
@@ -70,11 +71,24 @@ void CppBuilder::un_indent() {
 CppBackend::CppBackend() {
     this->compilation_unit = NULL;
     this->builder          = CppBuilder();
+    this->tracer           = NULL;
+    this->profile          = Profile::DEBUG;
+    this->line_starts      = std::unordered_map<CompilationUnit *, std::vector<u64>>();
 }
 
 std::string CppBackend::emit(CompilationBundle *bundle) {
     this->compilation_bundle = bundle;
     
+    // the profile is defined before core.h as it changes what core.h defines, the
+    // flags line is for whatever compiles this next e.g. tests/runner.py
+    if (this->profile == Profile::RELEASE) {
+        this->builder.append_line("// liamc profile release, compile with: -O2 -DNDEBUG -pthread");
+        this->builder.append_line("#define LIAM_PROFILE_RELEASE");
+    } else {
+        this->builder.append_line("// liamc profile debug, compile with: -O0 -g -pthread");
+        this->builder.append_line("#define LIAM_PROFILE_DEBUG");
+    }
+
     this->builder.append_line("#include <core.h>");
 
     for (CompilationUnit *cu : bundle->compilation_units) {
@@ -90,18 +104,37 @@ std::string CppBackend::emit(CompilationBundle *bundle) {
         }
     }
 
+    // every struct is declared before any fn as an instance of a generic fn is put in the
+    // namespace of the fn but can use the structs of whichever file called it
     for (CompilationUnit *cu : bundle->compilation_units) {
         this->compilation_unit = cu;
-        // forward declarations
         for (auto stmt : this->compilation_unit->top_level_struct_statements) {
             forward_declare_struct(stmt);
         }
+    }
 
+    for (CompilationUnit *cu : bundle->compilation_units) {
+        this->compilation_unit = cu;
+        // generic fns are only emitted as their instances
         for (auto stmt : this->compilation_unit->top_level_fn_statements) {
+            if (stmt->generic_params.empty()) {
+                forward_declare_function(stmt);
+            }
+        }
+
+        for (auto stmt : this->compilation_unit->generic_fn_instances) {
             forward_declare_function(stmt);
         }
     }
 
+    for (CompilationUnit *cu : bundle->compilation_units) {
+        this->compilation_unit = cu;
+        // the bytes of embedded files
+        for (EmbedExpression *expression : this->compilation_unit->embed_expressions) {
+            emit_embed_declaration(expression);
+        }
+    }
+
     this->builder.insert_new_line();
     for (SortingNode &node : bundle->sorted_types) {
         this->compilation_unit = node.type_info->defined_location->compilation_unit;
@@ -113,9 +146,21 @@ std::string CppBackend::emit(CompilationBundle *bundle) {
     this->builder.insert_new_line();
     for (CompilationUnit *cu : bundle->compilation_units) {
         this->compilation_unit = cu;
+        TraceSpan cu_span      = TraceSpan(this->tracer, trace_name(this->tracer, cu), "code gen");
 
         // function bodies
         for (auto stmt : this->compilation_unit->top_level_fn_statements) {
+            if (!stmt->generic_params.empty()) {
+                continue;
+            }
+
+            TraceSpan fn_span = TraceSpan(this->tracer, trace_name(this->tracer, cu, stmt), "code gen");
+            emit_fn_statement(stmt);
+        }
+
+        // each instance is emitted once however many calls there are to it
+        for (auto stmt : this->compilation_unit->generic_fn_instances) {
+            TraceSpan fn_span = TraceSpan(this->tracer, trace_name(this->tracer, cu, stmt), "code gen");
             emit_fn_statement(stmt);
         }
     }
@@ -147,27 +192,22 @@ void CppBackend::forward_declare_function(FnStatement *statement) {
     // namespace main {
     this->builder.append(std::format("namespace {} {{ ", get_namespace_name(this->compilation_unit)));
 
+    // __attribute__((hot))
+    emit_fn_tags(statement->tags);
+
     // i64
     emit_type_expression(statement->return_type);
     this->builder.append(" ");
 
-    std::string name = this->compilation_unit->get_token_string_from_index(statement->identifier);
-
     // main(
-    this->builder.append(name + "(");
-
-    u64 index = 0;
-    for (auto [token_index, type] : statement->params) {
-        std::string identifier_string = this->compilation_unit->get_token_string_from_index(token_index);
+    this->builder.append(fn_name(statement) + "(");
 
+    for (u64 index = 0; index < statement->params.size(); index++) {
         // i64 a,
-        emit_type_expression(type);
-        this->builder.append(" ");
-        this->builder.append(identifier_string);
+        emit_fn_param(statement, index);
         if (index + 1 < statement->params.size()) {
             this->builder.append(", ");
         }
-        index++;
     }
 
     // ); }
@@ -175,6 +215,66 @@ void CppBackend::forward_declare_function(FnStatement *statement) {
     this->builder.end_line();
 }
 
+void CppBackend::emit_fn_tags(Tags tags) {
+    // the definition comes after this declaration so these apply to it as well,
+    // always_inline needs the fn to be inline or gcc warns it might not be inlinable
+    static const std::tuple<u16, const char *> fn_attributes[] = {
+        {TAG_INLINE,   "__attribute__((always_inline)) inline "},
+        {TAG_NOINLINE, "__attribute__((noinline)) "             },
+        {TAG_HOT,      "__attribute__((hot)) "                  },
+        {TAG_COLD,     "__attribute__((cold)) "                 },
+        {TAG_FLATTEN,  "__attribute__((flatten)) "              },
+    };
+
+    for (auto &[flag, attribute] : fn_attributes) {
+        if ((tags.flags & flag) != 0) {
+            this->builder.append(attribute);
+        }
+    }
+}
+
+void CppBackend::emit_fn_param(FnStatement *statement, u64 index) {
+    // i64 a
+    // const BigStruct &a --> when passed by reference
+    // i64 *__restrict a --> #noalias a: ^i64
+    // Liam::NoAliasSlice<i64> a --> #noalias a: []i64
+    auto [identifier, type] = statement->params.at(index);
+    bool is_noalias         = (statement->param_tags.at(index).flags & TAG_NOALIAS) != 0;
+    if (statement->params_by_reference.at(index)) {
+        this->builder.append("const ");
+        emit_type_expression(type);
+        this->builder.append(" &");
+    } else if (is_noalias && type->type_info->type == TypeInfoType::POINTER) {
+        emit_type_expression(type);
+        this->builder.append(" __restrict ");
+    } else if (is_noalias) {
+        this->builder.append("Liam::NoAliasSlice<");
+        emit_type_expression(static_cast<SliceTypeExpression *>(type)->base_type);
+        this->builder.append("> ");
+    } else {
+        emit_type_expression(type);
+        this->builder.append(" ");
+    }
+
+    this->builder.append(this->compilation_unit->get_token_string_from_index(identifier));
+}
+
+u64 CppBackend::line_number(Span span) {
+    std::vector<u64> &line_starts = this->line_starts[this->compilation_unit];
+    if (line_starts.empty()) {
+        FileData *file_data = this->compilation_unit->file_data;
+        line_starts.push_back(0);
+        for (u64 i = 0; i < file_data->data_length; i++) {
+            if (file_data->data[i] == '\n') {
+                line_starts.push_back(i + 1);
+            }
+        }
+    }
+
+    // lines start from 1 to match what editors show
+    return std::upper_bound(line_starts.begin(), line_starts.end(), span.start) - line_starts.begin();
+}
+
 void CppBackend::emit_statement(Statement *statement) {
     switch (statement->statement_type) {
     case StatementType::RETURN:
@@ -302,20 +402,15 @@ void CppBackend::emit_fn_statement(FnStatement *statement) {
     this->builder.start_line();
     emit_type_expression(statement->return_type);
     this->builder.append(" ");
-    this->builder.append(this->compilation_unit->get_token_string_from_index(statement->identifier));
+    this->builder.append(fn_name(statement));
     this->builder.append("(");
 
     // params of the function
-    u64 index = 0;
-    for (auto [identifier, type] : statement->params) {
-        std::string identifier_string = this->compilation_unit->get_token_string_from_index(identifier);
-        emit_type_expression(type);
-        this->builder.append(" ");
-        this->builder.append(identifier_string);
+    for (u64 index = 0; index < statement->params.size(); index++) {
+        emit_fn_param(statement, index);
         if (index + 1 < statement->params.size()) {
             this->builder.append(", ");
         }
-        index++;
     }
 
     this->builder.append(")");
@@ -344,25 +439,93 @@ void CppBackend::emit_struct_statement(StructStatement *statement) {
 
     //      struct Main {
     this->builder.indent();
-    this->builder.append_line("struct " + this->compilation_unit->get_token_string_from_index(statement->identifier) +
-                              " {");
+    this->builder.start_line();
+    this->builder.append("struct ");
+    emit_alignment_tag(statement->tags);
+    this->builder.append(this->compilation_unit->get_token_string_from_index(statement->identifier) + " {");
+    this->builder.end_line();
 
     //          a: i64,
     //          b: i64
     this->builder.indent();
-    for (auto [identifier_token_index, type] : statement->members) {
+    for (u64 i = 0; i < statement->members.size(); i++) {
+        auto [identifier_token_index, type] = statement->members[i];
+        Tags member_tags                    = statement->member_tags[i];
+
+        // alignas(64) i64 a __attribute__((packed));
         this->builder.start_line();
+        emit_alignment_tag(member_tags);
         emit_type_expression(type);
         this->builder.append(" ");
-        this->builder.append(this->compilation_unit->get_token_string_from_index(identifier_token_index) + ";");
+        this->builder.append(this->compilation_unit->get_token_string_from_index(identifier_token_index));
+        if ((member_tags.flags & TAG_PACKED) != 0) {
+            this->builder.append(" __attribute__((packed))");
+        }
+        this->builder.append(";");
         this->builder.end_line();
     }
+
+    // structs used as hash map keys are compared and hashed member by member
+    if (statement->type_info->is_hash_key) {
+        emit_struct_hash_key_fns(statement);
+    }
     this->builder.un_indent();
 
-    // closing of the struct body
-    this->builder.append_line("};");
+    // closing of the struct body, packed goes after it as it cannot follow an alignas
+    // before the name
+    this->builder.append_line((statement->tags.flags & TAG_PACKED) != 0 ? "} __attribute__((packed));" : "};");
+    this->builder.un_indent();
+
+    this->builder.append_line("}");
+}
+
+void CppBackend::emit_alignment_tag(Tags tags) {
+    if ((tags.flags & TAG_ALIGN) != 0) {
+        this->builder.append(std::format("alignas({}) ", tags.alignment));
+    }
+}
+
+void CppBackend::emit_struct_hash_key_fns(StructStatement *statement) {
+    // bool operator==(const Main &other) const {
+    //     return Liam::equal(this->a, other.a) && Liam::equal(this->b, other.b);
+    // }
+    //
+    // uint64_t hash() const {
+    //     uint64_t __h = 0;
+    //     __h = Liam::hash_combine(__h, Liam::hash(this->a));
+    //     __h = Liam::hash_combine(__h, Liam::hash(this->b));
+    //     return __h;
+    // }
+    std::string name = this->compilation_unit->get_token_string_from_index(statement->identifier);
+
+    this->builder.append_line(std::format("bool operator==(const {} &other) const {{", name));
+    this->builder.indent();
+    this->builder.start_line();
+    this->builder.append("return ");
+    if (statement->members.size() == 0) {
+        this->builder.append("true");
+    }
+    for (u64 i = 0; i < statement->members.size(); i++) {
+        std::string member = this->compilation_unit->get_token_string_from_index(std::get<0>(statement->members[i]));
+        if (i > 0) {
+            this->builder.append(" && ");
+        }
+        this->builder.append(std::format("Liam::equal(this->{}, other.{})", member, member));
+    }
+    this->builder.append(";");
+    this->builder.end_line();
     this->builder.un_indent();
+    this->builder.append_line("}");
 
+    this->builder.append_line("uint64_t hash() const {");
+    this->builder.indent();
+    this->builder.append_line("uint64_t __h = 0;");
+    for (auto [identifier_token_index, _] : statement->members) {
+        std::string member = this->compilation_unit->get_token_string_from_index(identifier_token_index);
+        this->builder.append_line(std::format("__h = Liam::hash_combine(__h, Liam::hash(this->{}));", member));
+    }
+    this->builder.append_line("return __h;");
+    this->builder.un_indent();
     this->builder.append_line("}");
 }
 
@@ -383,8 +546,13 @@ void CppBackend::emit_expression_statement(ExpressionStatement *statement) {
 }
 
 void CppBackend::emit_for_statement(ForStatement *statement) {
-    if (statement->for_type == ForType::SLICE || statement->for_type == ForType::STATIC_ARRAY) {
+    if (statement->is_parallel) {
+        emit_parallel_for(statement);
+    } else if (statement->for_type == ForType::SLICE || statement->for_type == ForType::STATIC_ARRAY ||
+               statement->for_type == ForType::DYNAMIC_ARRAY) {
         emit_for_with_slice_or_array(statement);
+    } else if (statement->for_type == ForType::HASH_MAP) {
+        emit_for_with_hash_map(statement);
     } else if (statement->for_type == ForType::RANGE) {
         emit_for_with_range(statement);
     } else {
@@ -402,6 +570,8 @@ void CppBackend::emit_for_with_slice_or_array(ForStatement *statement) {
     //          { ... }
     //      }
     // }
+    // static arrays use their size from the type instead of __value_a->size
+    // so the trip count is a constant
 
     // compiler generated names used for the for loop
     // the value_name is only used when the expression passed is a r value and
@@ -426,8 +596,9 @@ void CppBackend::emit_for_with_slice_or_array(ForStatement *statement) {
     this->builder.append_line("{");
     this->builder.indent();
     this->builder.start_line();
+    // auto && so a temporary is kept alive for the loop without being copied
     if (iterating_over_r_value) {
-        this->builder.append(std::format("auto {} = ", to_be_indexed));
+        this->builder.append(std::format("auto &&{} = ", to_be_indexed));
     } else {
         this->builder.append(std::format("auto {} = &", to_be_indexed));
     }
@@ -435,6 +606,7 @@ void CppBackend::emit_for_with_slice_or_array(ForStatement *statement) {
     this->builder.append(";");
     this->builder.end_line();
 
+    emit_loop_tags(statement->tags);
     this->builder.start_line();
     this->builder.append("for (");
     this->builder.end_line();
@@ -450,7 +622,10 @@ void CppBackend::emit_for_with_slice_or_array(ForStatement *statement) {
     // if __value_a is a pointer then use -> else .
     this->builder.start_line();
     this->builder.append(std::format("{} < ", indexer));
-    if (iterating_over_r_value) {
+    if (statement->for_type == ForType::STATIC_ARRAY) {
+        auto static_array_type_info = static_cast<StaticArrayTypeInfo *>(statement->expression->type_info);
+        this->builder.append(std::format("{};", static_array_type_info->size));
+    } else if (iterating_over_r_value) {
         this->builder.append(std::format("{}.size;", to_be_indexed));
     } else {
         this->builder.append(std::format("{}->size;", to_be_indexed));
@@ -467,8 +642,17 @@ void CppBackend::emit_for_with_slice_or_array(ForStatement *statement) {
 
     //      auto value = (*__value_a)[__value_i];
     // if it is a r value then do not dereference as a pointer
+    // for ^value gets the address instead auto value = &(*__value_a)[__value_i];
+    // and when the body never changes value it is bound as a reference to skip the copy
     this->builder.start_line();
-    this->builder.append(std::format("{{ auto {} = ", value_identifier));
+    if (statement->value_is_pointer) {
+        this->builder.append(std::format("{{ auto {} = &", value_identifier));
+    } else if (statement->value_is_reference) {
+        this->builder.append(std::format("{{ auto &{} = ", value_identifier));
+    } else {
+        this->builder.append(std::format("{{ auto {} = ", value_identifier));
+    }
+
     if (iterating_over_r_value) {
         this->builder.append(std::format("{}[{}];", to_be_indexed, indexer));
     } else {
@@ -486,6 +670,46 @@ void CppBackend::emit_for_with_slice_or_array(ForStatement *statement) {
     this->builder.append_line("}");
 }
 
+void CppBackend::emit_for_with_hash_map(ForStatement *statement) {
+    // for entry : map { ... }
+    // generates:
+    // for (auto &__entry_e : map) {
+    //      { auto entry = __entry_e;
+    //      { ... }
+    //      }
+    // }
+    // the map iterator skips the empty slots a group of control bytes at a time
+
+    // entry
+    std::string value_identifier = this->compilation_unit->get_token_string_from_index(statement->value_identifier);
+
+    // __entry_e
+    std::string entry = std::format("__{}_e", value_identifier);
+
+    this->builder.start_line();
+    this->builder.append(std::format("for (auto &{} : ", entry));
+    emit_expression(statement->expression);
+    this->builder.append(") {");
+    this->builder.end_line();
+    this->builder.indent();
+
+    this->builder.start_line();
+    if (statement->value_is_reference) {
+        this->builder.append(std::format("{{ auto &{} = {};", value_identifier, entry));
+    } else {
+        this->builder.append(std::format("{{ auto {} = {};", value_identifier, entry));
+    }
+    this->builder.end_line();
+
+    emit_scope_statement(statement->body);
+
+    // closes the scope where we assign entry
+    this->builder.append_line("}");
+
+    this->builder.un_indent();
+    this->builder.append_line("}");
+}
+
 void CppBackend::emit_for_with_range(ForStatement *statement) {
     // for value : {a:b} { ... }
     // generates:
@@ -497,6 +721,7 @@ void CppBackend::emit_for_with_range(ForStatement *statement) {
     ASSERT(statement->expression->type == ExpressionType::RANGE);
     RangeExpression *range_expression = (RangeExpression *)(statement->expression);
 
+    emit_loop_tags(statement->tags);
     this->builder.append_line("for (");
     this->builder.indent();
 
@@ -530,10 +755,111 @@ void CppBackend::emit_for_with_range(ForStatement *statement) {
     emit_scope_statement(statement->body);
 }
 
+void CppBackend::emit_parallel_for(ForStatement *statement) {
+    // for par value : array { ... }
+    // generates:
+    // {
+    //      auto &&__value_a = array;
+    //      Liam::parallel_for(0, __value_a.size, grain, [&](i64 __value_begin, i64 __value_end) {
+    //          for (i64 __value_i = __value_begin; __value_i < __value_end; __value_i++) {
+    //              { auto value = __value_a[__value_i];
+    //              { ... }
+    //              }
+    //          }
+    //      });
+    // }
+    // ranges use their start and end instead of 0 and the size, and the value is
+    // the index cast back to the type of the range. The runtime splits the range
+    // into chunks of grain iterations and each thread runs the chunks it takes
+    // with the normal loop so continue works
+
+    std::string value_identifier = this->compilation_unit->get_token_string_from_index(statement->value_identifier);
+    std::string indexer          = std::format("__{}_i", value_identifier);
+    std::string to_be_indexed    = std::format("__{}_a", value_identifier);
+    std::string begin            = std::format("__{}_begin", value_identifier);
+    std::string end              = std::format("__{}_end", value_identifier);
+
+    this->builder.append_line("{");
+    this->builder.indent();
+
+    // auto && binds to the array if it is an lvalue and keeps it alive if it is not
+    if (statement->for_type != ForType::RANGE) {
+        this->builder.start_line();
+        this->builder.append(std::format("auto &&{} = ", to_be_indexed));
+        emit_expression(statement->expression);
+        this->builder.append(";");
+        this->builder.end_line();
+    }
+
+    // Liam::parallel_for(start, end, grain, [&](i64 __value_begin, i64 __value_end) {
+    this->builder.start_line();
+    this->builder.append("Liam::parallel_for(");
+    if (statement->for_type == ForType::RANGE) {
+        RangeExpression *range_expression = (RangeExpression *)(statement->expression);
+        emit_expression(range_expression->start);
+        this->builder.append(", ");
+        emit_expression(range_expression->end);
+    } else if (statement->for_type == ForType::STATIC_ARRAY) {
+        auto static_array_type_info = static_cast<StaticArrayTypeInfo *>(statement->expression->type_info);
+        this->builder.append(std::format("0, {}", static_array_type_info->size));
+    } else {
+        this->builder.append(std::format("0, {}.size", to_be_indexed));
+    }
+
+    // 0 lets the runtime pick the grain
+    this->builder.append(", ");
+    if (statement->grain != NULL) {
+        emit_expression(statement->grain);
+    } else {
+        this->builder.append("0");
+    }
+    this->builder.append(std::format(", [&](i64 {}, i64 {}) {{", begin, end));
+    this->builder.end_line();
+    this->builder.indent();
+
+    emit_loop_tags(statement->tags);
+    this->builder.append_line(
+        std::format("for (i64 {} = {}; {} < {}; {}++) {{", indexer, begin, indexer, end, indexer));
+    this->builder.indent();
+
+    this->builder.start_line();
+    if (statement->for_type == ForType::RANGE) {
+        auto        range_type_info = (NumberTypeInfo *)((RangeExpression *)statement->expression)->start->type_info;
+        std::string type_name       = number_type_name(range_type_info);
+        this->builder.append(std::format("{{ {} {} = ({}){};", type_name, value_identifier, type_name, indexer));
+    } else if (statement->value_is_pointer) {
+        this->builder.append(std::format("{{ auto {} = &{}[{}];", value_identifier, to_be_indexed, indexer));
+    } else if (statement->value_is_reference) {
+        this->builder.append(std::format("{{ auto &{} = {}[{}];", value_identifier, to_be_indexed, indexer));
+    } else {
+        this->builder.append(std::format("{{ auto {} = {}[{}];", value_identifier, to_be_indexed, indexer));
+    }
+    this->builder.end_line();
+
+    emit_scope_statement(statement->body);
+    this->builder.append_line("}");
+
+    // closes the chunk loop, the lambda and then the outer scope
+    this->builder.un_indent();
+    this->builder.append_line("}");
+    this->builder.un_indent();
+    this->builder.append_line("});");
+    this->builder.un_indent();
+    this->builder.append_line("}");
+}
+
+void CppBackend::emit_loop_tags(Tags tags) {
+    // __SIMD_LOOP is a pragma from core.h telling the compiler the iterations do not
+    // depend on each other, par loops put it on the loop each thread runs
+    if ((tags.flags & TAG_SIMD) != 0) {
+        this->builder.append_line("__SIMD_LOOP");
+    }
+}
+
 void CppBackend::emit_if_statement(IfStatement *statement) {
     builder.start_line();
     builder.append("if (");
-    emit_expression(statement->expression);
+    emit_branch_condition(statement->expression, statement->tags);
     builder.append(")");
     builder.end_line();
 
@@ -560,10 +886,12 @@ void CppBackend::emit_continue_statement(ContinueStatement *statement) {
 }
 
 void CppBackend::emit_print_statement(PrintStatement *statement) {
+    // print x --> Liam::print(x);
+    // this goes into a buffer in core.h that is written to stdout in big blocks
     this->builder.start_line();
-    this->builder.append("std::cout << ");
+    this->builder.append("Liam::print(");
     emit_expression(statement->expression);
-    this->builder.append(" << \"\\n\" ;");
+    this->builder.append(");");
     this->builder.end_line();
 }
 
@@ -578,12 +906,25 @@ void CppBackend::emit_assert_statement(AssertStatement *statement) {
 void CppBackend::emit_while_statement(WhileStatement *statement) {
     this->builder.start_line();
     this->builder.append("while(");
-    emit_expression(statement->expression);
+    emit_branch_condition(statement->expression, statement->tags);
     this->builder.append(")");
     this->builder.end_line();
     emit_scope_statement(statement->body);
 }
 
+void CppBackend::emit_branch_condition(Expression *expression, Tags tags) {
+    // __builtin_expect(x, 0)
+    // [[likely]] is c++20 and the output is c++17 so the hint goes on the condition instead
+    if ((tags.flags & (TAG_LIKELY | TAG_UNLIKELY)) == 0) {
+        emit_expression(expression);
+        return;
+    }
+
+    this->builder.append("__builtin_expect(");
+    emit_expression(expression);
+    this->builder.append((tags.flags & TAG_LIKELY) != 0 ? ", 1)" : ", 0)");
+}
+
 void CppBackend::emit_expression(Expression *expression) {
     switch (expression->type) {
     case ExpressionType::STRING_LITERAL:
@@ -631,6 +972,12 @@ void CppBackend::emit_expression(Expression *expression) {
     case ExpressionType::SUBSCRIPT:
         emit_subscript_expression(static_cast<SubscriptExpression *>(expression));
         break;
+    case ExpressionType::ARENA_SLICE:
+        emit_arena_slice_expression(static_cast<ArenaSliceExpression *>(expression));
+        break;
+    case ExpressionType::EMBED:
+        emit_embed_expression(static_cast<EmbedExpression *>(expression));
+        break;
     case ExpressionType::RANGE:
         ASSERT_MSG(false, "range expressions are handled by the expression are they are in, they have no analog in "
                           "cpp, cannot emit on their own");
@@ -707,48 +1054,40 @@ void CppBackend::emit_bool_literal_expression(BoolLiteralExpression *expression)
 void CppBackend::emit_number_literal_expression(NumberLiteralExpression *expression) {
     auto number_type = static_cast<NumberTypeInfo *>(expression->type_info);
 
-    this->builder.append("Liam::make_");
-
-    if (number_type->number_type == NumberType::SIGNED) {
-        this->builder.append("i");
-    } else if (number_type->number_type == NumberType::UNSIGNED) {
-        this->builder.append("u");
-    } else if (number_type->number_type == NumberType::FLOAT) {
-        this->builder.append("f");
-    }
-
-    switch (number_type->size) {
-    case NumberSize::SIZE_8:
-        this->builder.append("8");
-        break;
-    case NumberSize::SIZE_16:
-        this->builder.append("16");
-        break;
-    case NumberSize::SIZE_32:
-        this->builder.append("32");
-        break;
-    case NumberSize::SIZE_64:
-        this->builder.append("64");
-        break;
-    default:
-        UNREACHABLE();
-    }
-
-    this->builder.append("(");
+    // literals are emitted as native c++ literals of the right type so they can be
+    // used in constant expressions and clang doesnt have to inline a call for each
+    // 5 --> INT64_C(5)
+    // 5u8 --> (u8)5
+    // 1.5f32 --> 1.5f
+    // there is one of these for every literal so the pieces are appended on their own,
+    // going through std::format for each one made code gen of big tables several times slower
     switch (number_type->number_type) {
-    case NumberType::SIGNED:
-        this->builder.append(std::to_string(expression->value.i));
-        break;
-    case NumberType::UNSIGNED:
-        this->builder.append(std::to_string(expression->value.u));
-        break;
-    case NumberType::FLOAT:
-        this->builder.append(std::to_string(expression->value.f));
-        break;
+    case NumberType::SIGNED: {
+        if (number_type->size == NumberSize::SIZE_64) {
+            this->builder.append("INT64_C(");
+            this->builder.append(std::to_string(expression->value.i));
+            this->builder.append(")");
+        } else {
+            this->builder.append("(" + number_type_name(number_type) + ")");
+            this->builder.append(std::to_string(expression->value.i));
+        }
+    } break;
+    case NumberType::UNSIGNED: {
+        if (number_type->size == NumberSize::SIZE_64) {
+            this->builder.append("UINT64_C(");
+            this->builder.append(std::to_string(expression->value.u));
+            this->builder.append(")");
+        } else {
+            this->builder.append("(" + number_type_name(number_type) + ")");
+            this->builder.append(std::to_string(expression->value.u));
+        }
+    } break;
+    case NumberType::FLOAT: {
+        this->builder.append(float_literal_string(expression->value.f, number_type->size));
+    } break;
     default:
         UNREACHABLE();
     }
-    this->builder.append(")");
 }
 
 void CppBackend::emit_unary_expression(UnaryExpression *expression) {
@@ -776,8 +1115,15 @@ void CppBackend::emit_unary_expression(UnaryExpression *expression) {
 }
 
 void CppBackend::emit_call_expression(CallExpression *expression) {
-    emit_expression(expression->callee);
-    this->builder.append("(");
+    // max(a, b) --> main::__max_0(a, b) when max is generic
+    if (expression->generic_instance != NULL) {
+        FnStatement *instance = expression->generic_instance;
+        this->builder.append(
+            std::format("{}::{}(", get_namespace_name(instance->compilation_unit), fn_name(instance)));
+    } else {
+        emit_expression(expression->callee);
+        this->builder.append("(");
+    }
 
     u64 index = 0;
     for (auto expr : expression->args) {
@@ -792,6 +1138,11 @@ void CppBackend::emit_call_expression(CallExpression *expression) {
 }
 
 void CppBackend::emit_identifier_expression(IdentifierExpression *expression) {
+    // map_file(...) --> Liam::map_file(...)
+    if (expression->type_info->type == TypeInfoType::FN && ((FnTypeInfo *)expression->type_info)->is_builtin) {
+        this->builder.append("Liam::");
+    }
+
     this->builder.append(this->compilation_unit->get_token_string_from_index(expression->identifier));
 }
 
@@ -802,7 +1153,8 @@ void CppBackend::emit_get_expression(GetExpression *expression) {
 
     if (expression->lhs->type_info->type == TypeInfoType::POINTER) {
         this->builder.append("->");
-    } else if (expression->lhs->type_info->type == TypeInfoType::NAMESPACE) {
+    } else if (expression->lhs->type_info->type == TypeInfoType::NAMESPACE ||
+               expression->lhs->type_info->type == TypeInfoType::TYPE) {
         this->builder.append("::");
     } else {
         this->builder.append(".");
@@ -830,6 +1182,13 @@ void CppBackend::emit_instantiate_expression(InstantiateExpression *expression)
 }
 
 void CppBackend::emit_struct_instance_expression(StructInstanceExpression *expression) {
+    // new(arena) T{...} --> Liam::allocate_in(arena, T{...})
+    if (expression->allocator != NULL) {
+        this->builder.append("Liam::allocate_in(");
+        emit_allocator(expression->allocator);
+        this->builder.append(", ");
+    }
+
     emit_type_expression(expression->type_expression);
     this->builder.append("{");
     u64 index = 0;
@@ -841,16 +1200,42 @@ void CppBackend::emit_struct_instance_expression(StructInstanceExpression *expre
         index++;
     }
     this->builder.append("}");
+
+    if (expression->allocator != NULL) {
+        this->builder.append(")");
+    }
+}
+
+void CppBackend::emit_arena_slice_expression(ArenaSliceExpression *expression) {
+    // arena_slice(arena, T, count) --> Liam::arena_slice<T>(arena, count)
+    this->builder.append("Liam::arena_slice<");
+    emit_type_expression(expression->type_expression);
+    this->builder.append(">(");
+    emit_allocator(expression->arena);
+    this->builder.append(", ");
+    emit_expression(expression->count);
+    this->builder.append(")");
+}
+
+void CppBackend::emit_allocator(Expression *allocator) {
+    // the runtime takes the allocator by reference so pointers to one are dereferenced
+    if (allocator->type_info->type == TypeInfoType::POINTER) {
+        this->builder.append("*(");
+        emit_expression(allocator);
+        this->builder.append(")");
+    } else {
+        emit_expression(allocator);
+    }
 }
 
 void CppBackend::emit_static_array_literal_expression(StaticArrayExpression *expression) {
+    // aggregate initialisation so constant tables can be built at compile time
+    // Liam::StaticArray<3, i64>{{INT64_C(1), INT64_C(2), INT64_C(3)}}
     this->builder.append("Liam::StaticArray<");
-    emit_number_literal_expression(expression->number);
+    this->builder.append(std::to_string(expression->number->value.i));
     this->builder.append(", ");
     emit_type_expression(expression->type_expression);
-    this->builder.append(">(std::initializer_list<");
-    emit_type_expression(expression->type_expression);
-    this->builder.append(">({");
+    this->builder.append(">{{");
 
     // expression list
     u64 index = 0;
@@ -863,42 +1248,64 @@ void CppBackend::emit_static_array_literal_expression(StaticArrayExpression *exp
         index++;
     }
 
-    this->builder.append("}))");
+    this->builder.append("}}");
 }
 
 void CppBackend::emit_subscript_expression(SubscriptExpression *expression) {
     emit_expression(expression->subscriptee);
     if (expression->subscripter->type != ExpressionType::RANGE) {
+        // debug builds check every index that might be out of bounds and say where
+        // in the liam code it went wrong
+        // array[i] --> array.checked_index(i, "main.liam", 12)
+        if (this->profile == Profile::DEBUG && !expression->in_bounds) {
+            this->builder.append(".checked_index(");
+            emit_expression(expression->subscripter);
+            this->builder.append(std::format(", \"{}\", {})",
+                                             this->compilation_unit->file_data->absolute_path.generic_string(),
+                                             line_number(expression->span)));
+            return;
+        }
+
         this->builder.append("[");
         emit_expression(expression->subscripter);
         this->builder.append("]");
         return;
     } else {
         ASSERT(expression->subscripter->type == ExpressionType::RANGE);
-        emit_range_slicing_expression(static_cast<RangeExpression *>(expression->subscripter));
+        emit_range_slicing_expression(expression);
     }
 }
 
-void CppBackend::emit_range_slicing_expression(RangeExpression *expression) {
+void CppBackend::emit_range_slicing_expression(SubscriptExpression *subscript_expression) {
     // there are 4 cases we need to handle
     // 1. [a..b] -> slice_with_start_and_end(a, b)
     // 2. [a..] -> slice_with_start(a)
     // 3. [..b] -> slice_with_end(b)
     // 4. [..] -> slice_full()
+    // debug builds use the checked versions which also take where it is in the liam code
+    // [a..b] --> checked_slice_with_start_and_end(a, b, "main.liam", 12)
+    auto        expression = static_cast<RangeExpression *>(subscript_expression->subscripter);
+    std::string checked    = this->profile == Profile::DEBUG ? "checked_" : "";
+    std::string location   = "";
+    if (this->profile == Profile::DEBUG) {
+        location = std::format(", \"{}\", {}", this->compilation_unit->file_data->absolute_path.generic_string(),
+                               line_number(subscript_expression->span));
+    }
+
     if (expression->start && expression->end) {
-        this->builder.append(".slice_with_start_and_end(");
+        this->builder.append(std::format(".{}slice_with_start_and_end(", checked));
         emit_expression(expression->start);
         this->builder.append(", ");
         emit_expression(expression->end);
-        this->builder.append(")");
+        this->builder.append(location + ")");
     } else if (expression->start) {
-        this->builder.append(".slice_with_start(");
+        this->builder.append(std::format(".{}slice_with_start(", checked));
         emit_expression(expression->start);
-        this->builder.append(")");
+        this->builder.append(location + ")");
     } else if (expression->end) {
-        this->builder.append(".slice_with_end(");
+        this->builder.append(std::format(".{}slice_with_end(", checked));
         emit_expression(expression->end);
-        this->builder.append(")");
+        this->builder.append(location + ")");
     } else {
         this->builder.append(".slice_full()");
     }
@@ -921,6 +1328,15 @@ void CppBackend::emit_type_expression(TypeExpression *type_expression) {
     case TypeExpressionType::TYPE_SLICE:
         emit_slice_type_expression(static_cast<SliceTypeExpression *>(type_expression));
         break;
+    case TypeExpressionType::TYPE_POOL:
+        emit_pool_type_expression(static_cast<PoolTypeExpression *>(type_expression));
+        break;
+    case TypeExpressionType::TYPE_DYNAMIC_ARRAY:
+        emit_dynamic_array_type_expression(static_cast<DynamicArrayTypeExpression *>(type_expression));
+        break;
+    case TypeExpressionType::TYPE_HASH_MAP:
+        emit_hash_map_type_expression(static_cast<HashMapTypeExpression *>(type_expression));
+        break;
     default:
         UNREACHABLE();
     }
@@ -936,9 +1352,100 @@ void CppBackend::emit_unary_type_expression(UnaryTypeExpression *type_expression
 }
 
 void CppBackend::emit_identifier_type_expression(IdentifierTypeExpression *type_expression) {
+    // T in a generic fn instance is whatever type it was given
+    if (type_expression->is_generic_param) {
+        emit_type_info(type_expression->type_info);
+        return;
+    }
+
     this->builder.append(this->compilation_unit->get_token_string_from_index(type_expression->identifier));
 }
 
+void CppBackend::emit_type_info(TypeInfo *type_info) {
+    switch (type_info->type) {
+    case TypeInfoType::NUMBER:
+        this->builder.append(number_type_name((NumberTypeInfo *)type_info));
+        break;
+    case TypeInfoType::BOOLEAN:
+        this->builder.append("bool");
+        break;
+    case TypeInfoType::VOID:
+        this->builder.append("void");
+        break;
+    case TypeInfoType::ARENA:
+        this->builder.append("Liam::Arena");
+        break;
+    case TypeInfoType::POINTER:
+        emit_type_info(((PointerTypeInfo *)type_info)->to);
+        this->builder.append("*");
+        break;
+    case TypeInfoType::SLICE:
+        this->builder.append("Liam::Slice<");
+        emit_type_info(((SliceTypeInfo *)type_info)->base_type);
+        this->builder.append(">");
+        break;
+    case TypeInfoType::STATIC_ARRAY: {
+        auto static_array_type_info = (StaticArrayTypeInfo *)type_info;
+        this->builder.append(std::format("Liam::StaticArray<{}, ", static_array_type_info->size));
+        emit_type_info(static_array_type_info->base_type);
+        this->builder.append(">");
+    } break;
+    case TypeInfoType::VECTOR: {
+        auto vector_type_info = (VectorTypeInfo *)type_info;
+        this->builder.append(
+            std::format("{}x{}", number_type_name(vector_type_info->base_type), vector_type_info->lanes));
+    } break;
+    case TypeInfoType::POOL:
+        this->builder.append("Liam::Pool<");
+        emit_type_info(((PoolTypeInfo *)type_info)->base_type);
+        this->builder.append(">");
+        break;
+    case TypeInfoType::DYNAMIC_ARRAY:
+        this->builder.append("Liam::Array<");
+        emit_type_info(((DynamicArrayTypeInfo *)type_info)->base_type);
+        this->builder.append(">");
+        break;
+    case TypeInfoType::HASH_MAP: {
+        auto hash_map_type_info = (HashMapTypeInfo *)type_info;
+        this->builder.append("Liam::HashMap<");
+        emit_type_info(hash_map_type_info->key_type);
+        this->builder.append(", ");
+        emit_type_info(hash_map_type_info->value_type);
+        this->builder.append(">");
+    } break;
+    case TypeInfoType::STRUCT: {
+        // hash map entries have no statement, they are Liam::HashMap<K, V>::Entry
+        auto struct_type_info = (StructTypeInfo *)type_info;
+        if (struct_type_info->defined_location == NULL) {
+            TypeInfo *key_type_info   = std::get<1>(struct_type_info->members.at(0));
+            TypeInfo *value_type_info = std::get<1>(struct_type_info->members.at(1));
+            this->builder.append("Liam::HashMap<");
+            emit_type_info(key_type_info);
+            this->builder.append(", ");
+            emit_type_info(value_type_info);
+            this->builder.append(">::Entry");
+            break;
+        }
+
+        StructStatement *statement  = struct_type_info->defined_location;
+        std::string      identifier = statement->compilation_unit->get_token_string_from_index(statement->identifier);
+        this->builder.append(std::format("{}::{}", get_namespace_name(statement->compilation_unit), identifier));
+    } break;
+    default:
+        UNREACHABLE();
+    }
+}
+
+std::string CppBackend::fn_name(FnStatement *statement) {
+    // instances of generic fns get the index they were made at so they do not overload each other
+    std::string name = statement->compilation_unit->get_token_string_from_index(statement->identifier);
+    if (statement->generic_params.empty()) {
+        return name;
+    }
+
+    return std::format("__{}_{}", name, statement->instance_index);
+}
+
 void CppBackend::emit_get_type_expression(GetTypeExpression *type_expression) {
     std::string identifier = this->compilation_unit->get_token_string_from_index(type_expression->identifier);
 
@@ -954,9 +1461,7 @@ void CppBackend::emit_get_type_expression(GetTypeExpression *type_expression) {
 }
 
 void CppBackend::emit_static_array_type_expression(StaticArrayTypeExpression *type_expression) {
-    this->builder.append("Liam::StaticArray<");
-    emit_number_literal_expression(type_expression->size);
-    this->builder.append(", ");
+    this->builder.append(std::format("Liam::StaticArray<{}, ", type_expression->size->value.i));
     emit_type_expression(type_expression->base_type);
     this->builder.append(">");
 }
@@ -967,6 +1472,70 @@ void CppBackend::emit_slice_type_expression(SliceTypeExpression *type_expression
     this->builder.append(">");
 }
 
+void CppBackend::emit_pool_type_expression(PoolTypeExpression *type_expression) {
+    this->builder.append("Liam::Pool<");
+    emit_type_expression(type_expression->base_type);
+    this->builder.append(">");
+}
+
+void CppBackend::emit_dynamic_array_type_expression(DynamicArrayTypeExpression *type_expression) {
+    this->builder.append("Liam::Array<");
+    emit_type_expression(type_expression->base_type);
+    this->builder.append(">");
+}
+
+void CppBackend::emit_hash_map_type_expression(HashMapTypeExpression *type_expression) {
+    this->builder.append("Liam::HashMap<");
+    emit_type_expression(type_expression->key_type);
+    this->builder.append(", ");
+    emit_type_expression(type_expression->value_type);
+    this->builder.append(">");
+}
+
+void CppBackend::emit_embed_declaration(EmbedExpression *expression) {
+    // embed i32 "table.bin" in main.liam, 4096 bytes
+    // generates:
+    // __asm__(".pushsection .rodata\n.balign 64\n__liam_embed_main_0:\n.incbin \"/path/table.bin\"\n.popsection");
+    // extern "C" const Liam::StaticArray<1024, i32> __liam_embed_main_0;
+    // the assembler copies the file into the executable so it is never parsed or
+    // initialised at startup, the array type has the same layout as the raw bytes
+    std::string symbol = embed_symbol(expression);
+
+    // the path is a string in the assembly which is in a string in the c++, so
+    // quotes and backslashes are escaped twice
+    std::string path;
+    for (char c : expression->absolute_path) {
+        if (c == '"' || c == '\\') {
+            path += "\\\\\\";
+        }
+        path += c;
+    }
+
+    this->builder.start_line();
+    this->builder.append("__asm__(\".pushsection .rodata\\n.balign 64\\n");
+    this->builder.append(std::format("{}:\\n.incbin \\\"{}\\\"\\n.popsection\");", symbol, path));
+    this->builder.end_line();
+
+    auto static_array_type_info = (StaticArrayTypeInfo *)expression->type_info;
+    this->builder.start_line();
+    this->builder.append(std::format("extern \"C\" const Liam::StaticArray<{}, ", static_array_type_info->size));
+    if (expression->element_type != NULL) {
+        emit_type_expression(expression->element_type);
+    } else {
+        this->builder.append("u8");
+    }
+    this->builder.append(std::format("> {};", symbol));
+    this->builder.end_line();
+}
+
+void CppBackend::emit_embed_expression(EmbedExpression *expression) {
+    this->builder.append(embed_symbol(expression));
+}
+
+std::string CppBackend::embed_symbol(EmbedExpression *expression) {
+    return std::format("__liam_embed_{}_{}", get_namespace_name(this->compilation_unit), expression->index);
+}
+
 std::string strip_semi_colon(std::string str) {
     if (str.size() == 0)
         return str;
@@ -989,6 +1558,64 @@ u64 string_literal_length(std::string *string) {
     return string->size() - 2;
 }
 
+std::string float_literal_string(f64 value, NumberSize size) {
+    // std::to_chars gives the shortest string that reads back as the exact same
+    // value, std::to_string would round everything to 6 decimal places
+    char  buffer[32];
+    char *end = NULL;
+    if (size == NumberSize::SIZE_32) {
+        end = std::to_chars(buffer, buffer + sizeof(buffer), (f32)value).ptr;
+    } else {
+        end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+    }
+
+    std::string literal = std::string(buffer, end);
+
+    // whole numbers come out as 100 which c++ would read as an int
+    if (literal.find_first_of(".e") == std::string::npos) {
+        literal.append(".0");
+    }
+
+    // f32 needs the suffix or it is read as a double and then rounded a second time
+    if (size == NumberSize::SIZE_32) {
+        literal.append("f");
+    }
+
+    return literal;
+}
+
+std::string number_type_name(NumberTypeInfo *number_type) {
+    std::string name;
+    switch (number_type->number_type) {
+    case NumberType::SIGNED:
+        name = "i";
+        break;
+    case NumberType::UNSIGNED:
+        name = "u";
+        break;
+    case NumberType::FLOAT:
+        name = "f";
+        break;
+    default:
+        UNREACHABLE();
+    }
+
+    switch (number_type->size) {
+    case NumberSize::SIZE_8:
+        return name + "8";
+    case NumberSize::SIZE_16:
+        return name + "16";
+    case NumberSize::SIZE_32:
+        return name + "32";
+    case NumberSize::SIZE_64:
+        return name + "64";
+    default:
+        UNREACHABLE();
+    }
+
+    return name;
+}
+
 std::string get_namespace_name(CompilationUnit *compilation_unit) {
     return compilation_unit->file_data->absolute_path.stem().string();
 }
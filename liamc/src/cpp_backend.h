@@ -1,8 +1,12 @@
 #pragma once
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "args.h"
 #include "ast.h"
 #include "parser.h"
+#include "trace.h"
 #include "type_checker.h"
 
 // If defined, the CppBuiler will also print to stdout
@@ -30,14 +34,26 @@ struct CppBackend {
     CompilationUnit   *compilation_unit;
     CompilationBundle *compilation_bundle;
     CppBuilder         builder;
+    Tracer            *tracer;
+    Profile            profile;
+
+    // offsets of the start of each line in each file, only made when they are
+    // needed to give the line of a subscript for bounds checking
+    std::unordered_map<CompilationUnit *, std::vector<u64>> line_starts;
 
     CppBackend();
 
     std::string emit(CompilationBundle *bundle);
 
-    void forward_declare_namespace(CompilationUnit *compilation_unit);
-    void forward_declare_struct(StructStatement *statement);
-    void forward_declare_function(FnStatement *statement);
+    void        forward_declare_namespace(CompilationUnit *compilation_unit);
+    void        forward_declare_struct(StructStatement *statement);
+    void        forward_declare_function(FnStatement *statement);
+    void        emit_fn_param(FnStatement *statement, u64 index);
+    void        emit_fn_tags(Tags tags);
+    void        emit_embed_declaration(EmbedExpression *expression);
+    std::string embed_symbol(EmbedExpression *expression);
+    std::string fn_name(FnStatement *statement);
+    u64         line_number(Span span);
 
     void emit_statement(Statement *statement);
     void emit_import_statement(ImportStatement *statement);
@@ -47,17 +63,23 @@ struct CppBackend {
     void emit_scope_statement(ScopeStatement *statement);
     void emit_fn_statement(FnStatement *statement);
     void emit_struct_statement(StructStatement *statement);
+    void emit_struct_hash_key_fns(StructStatement *statement);
+    void emit_alignment_tag(Tags tags);
     void emit_assigment_statement(AssigmentStatement *statement);
     void emit_expression_statement(ExpressionStatement *statement);
     void emit_for_statement(ForStatement *statement);
     void emit_for_with_slice_or_array(ForStatement *statement);
+    void emit_for_with_hash_map(ForStatement *statement);
     void emit_for_with_range(ForStatement *statement);
+    void emit_parallel_for(ForStatement *statement);
+    void emit_loop_tags(Tags tags);
     void emit_if_statement(IfStatement *statement);
     void emit_else_statement(ElseStatement *statement);
     void emit_continue_statement(ContinueStatement *statement);
     void emit_print_statement(PrintStatement *statement);
     void emit_assert_statement(AssertStatement *statement);
     void emit_while_statement(WhileStatement *statement);
+    void emit_branch_condition(Expression *expression, Tags tags);
 
     void emit_expression(Expression *expression);
     void emit_binary_expression(BinaryExpression *expression);
@@ -73,9 +95,12 @@ struct CppBackend {
     void emit_zero_literal_expression(ZeroLiteralExpression *expression);
     void emit_instantiate_expression(InstantiateExpression *expression);
     void emit_struct_instance_expression(StructInstanceExpression *expression);
+    void emit_arena_slice_expression(ArenaSliceExpression *expression);
+    void emit_embed_expression(EmbedExpression *expression);
+    void emit_allocator(Expression *allocator);
     void emit_static_array_literal_expression(StaticArrayExpression *expression);
     void emit_subscript_expression(SubscriptExpression *expression);
-    void emit_range_slicing_expression(RangeExpression *expression);
+    void emit_range_slicing_expression(SubscriptExpression *subscript_expression);
 
     void emit_type_expression(TypeExpression *type_expression);
     void emit_unary_type_expression(UnaryTypeExpression *type_expression);
@@ -83,8 +108,14 @@ struct CppBackend {
     void emit_get_type_expression(GetTypeExpression *type_expression);
     void emit_static_array_type_expression(StaticArrayTypeExpression *type_expression);
     void emit_slice_type_expression(SliceTypeExpression *type_expression);
+    void emit_pool_type_expression(PoolTypeExpression *type_expression);
+    void emit_dynamic_array_type_expression(DynamicArrayTypeExpression *type_expression);
+    void emit_hash_map_type_expression(HashMapTypeExpression *type_expression);
+    void emit_type_info(TypeInfo *type_info);
 };
 
 std::string strip_semi_colon(std::string str);
 u64         string_literal_length(std::string *string);
+std::string float_literal_string(f64 value, NumberSize size);
+std::string number_type_name(NumberTypeInfo *number_type);
 std::string get_namespace_name(CompilationUnit *compilation_unit);
@@ -13,11 +13,9 @@
 #define BLUE "\033[34m"
 #define DEFAULT "\033[0m"
 
-ErrorReporter *ErrorReporter::singleton = NULL;
-
-void ParserError::print_error_message() {
+void ParserError::print_error_message(FileManager *file_manager) {
     std::cerr << std::format("{}Parsing error :: {}{}\n", RED, error, DEFAULT);
-    write_error_annotation_at_span(&this->file, this->span);
+    write_error_annotation_at_span(file_manager, &this->file, this->span);
 }
 
 TypeCheckerError TypeCheckerError::make(std::string file) {
@@ -52,27 +50,27 @@ TypeCheckerError &TypeCheckerError::set_message(std::string message) {
     return *this;
 }
 
-void TypeCheckerError::report() {
-    ErrorReporter::report_type_checker_error(*this);
+void TypeCheckerError::report(ErrorReporter *error_reporter) {
+    error_reporter->report_type_checker_error(*this);
 }
 
-void TypeCheckerError::print_error_message() {
+void TypeCheckerError::print_error_message(FileManager *file_manager) {
     std::cerr << std::format("{}Type checking error :: {}{}\n", RED, error, DEFAULT);
 
     if (this->expr_1) {
-        write_error_annotation_at_span(&file, this->expr_1->span);
+        write_error_annotation_at_span(file_manager, &file, this->expr_1->span);
     }
 
     if (this->expr_2) {
-        write_error_annotation_at_span(&file, this->expr_2->span);
+        write_error_annotation_at_span(file_manager, &file, this->expr_2->span);
     }
 
     if (this->type_expr_1) {
-        write_error_annotation_at_span(&file, this->type_expr_1->span);
+        write_error_annotation_at_span(file_manager, &file, this->type_expr_1->span);
     }
 
     if (this->type_expr_2) {
-        write_error_annotation_at_span(&file, this->type_expr_2->span);
+        write_error_annotation_at_span(file_manager, &file, this->type_expr_2->span);
     }
 }
 
@@ -83,60 +81,38 @@ ErrorReporter::ErrorReporter() {
 }
 
 void ErrorReporter::report_parser_error(std::string file, Span span, std::string message) {
-    if (ErrorReporter::singleton == nullptr) {
-        ErrorReporter::singleton = new ErrorReporter();
-    }
-
-    ErrorReporter::singleton->parse_errors.push_back(ParserError{std::move(file), span, std::move(message)});
-    ErrorReporter::singleton->errors_since_last_check++;
+    this->parse_errors.push_back(ParserError{std::move(file), span, std::move(message)});
+    this->errors_since_last_check++;
 }
 
 void ErrorReporter::report_type_checker_error(std::string file, Expression *expr_1, Expression *expr_2,
                                               TypeExpression *type_expr_1, TypeExpression *type_expr_2,
                                               std::string message) {
-    if (ErrorReporter::singleton == nullptr) {
-        ErrorReporter::singleton = new ErrorReporter();
-    }
-
-    ErrorReporter::singleton->type_check_errors.push_back(TypeCheckerError{.file        = std::move(file),
-                                                                           .expr_1      = expr_1,
-                                                                           .expr_2      = expr_2,
-                                                                           .type_expr_1 = type_expr_1,
-                                                                           .type_expr_2 = type_expr_2,
-                                                                           .error       = std::move(message)});
+    this->type_check_errors.push_back(TypeCheckerError{.file        = std::move(file),
+                                                       .expr_1      = expr_1,
+                                                       .expr_2      = expr_2,
+                                                       .type_expr_1 = type_expr_1,
+                                                       .type_expr_2 = type_expr_2,
+                                                       .error       = std::move(message)});
 
-    ErrorReporter::singleton->errors_since_last_check++;
+    this->errors_since_last_check++;
 }
 
 void ErrorReporter::report_type_checker_error(TypeCheckerError error) {
-    if (ErrorReporter::singleton == nullptr) {
-        ErrorReporter::singleton = new ErrorReporter();
-    }
-
-    ErrorReporter::singleton->type_check_errors.push_back(error);
-    ErrorReporter::singleton->errors_since_last_check++;
+    this->type_check_errors.push_back(error);
+    this->errors_since_last_check++;
 }
 
 bool ErrorReporter::has_parse_errors() {
-    if (ErrorReporter::singleton == nullptr)
-        return false;
-
-    return !(ErrorReporter::singleton->parse_errors.empty());
+    return !(this->parse_errors.empty());
 }
 
 bool ErrorReporter::has_type_check_errors() {
-    if (ErrorReporter::singleton == nullptr)
-        return false;
-
-    return !(ErrorReporter::singleton->type_check_errors.empty());
+    return !(this->type_check_errors.empty());
 }
 
 bool ErrorReporter::has_error_since_last_check() {
-    if (ErrorReporter::singleton == nullptr)
-        return false;
-
-    u64 error_count = ErrorReporter::singleton->errors_since_last_check;
-    return error_count > 0;
+    return this->errors_since_last_check > 0;
 }
 
 void ErrorReporter::reset_errors() {
@@ -144,20 +120,14 @@ void ErrorReporter::reset_errors() {
     // even after we have an erroe. Right now if there is an error it will
     // stop everything. Use this for example after each fn in type checking
     // to have multiple errors
-    if (ErrorReporter::singleton == nullptr)
-        return;
-
-    ErrorReporter::singleton->errors_since_last_check = 0;
+    this->errors_since_last_check = 0;
 }
 
 u64 ErrorReporter::error_count() {
-    if (ErrorReporter::singleton == nullptr)
-        return 0;
-
-    return ErrorReporter::singleton->parse_errors.size() + ErrorReporter::singleton->type_check_errors.size();
+    return this->parse_errors.size() + this->type_check_errors.size();
 }
 
-void write_error_annotation_at_span(std::string *file, Span span) {
+void write_error_annotation_at_span(FileManager *file_manager, std::string *file, Span span) {
     // TODO add locations of errors
     // right now we are not printing the line and character location
     // of the error, this is kind of okay for type errors but
@@ -171,7 +141,14 @@ void write_error_annotation_at_span(std::string *file, Span span) {
     // ends at
 
     ASSERT(span.start <= span.end);
-    FileData *file_data = FileManager::load_relative_from_cwd(*file).value();
+
+    // errors about files that could not be loaded have nothing to annotate
+    Option<FileData *> loaded_file_data = file_manager->load_relative_from_cwd(*file);
+    if (!loaded_file_data.is_some()) {
+        return;
+    }
+
+    FileData *file_data = loaded_file_data.value();
 
     // the span can point to any part of a line, maybe even and single character
     // we move the start of the span the start of whatever line it is one
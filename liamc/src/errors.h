@@ -6,12 +6,15 @@
 #include "ast.h"
 #include "liam.h"
 
+struct ErrorReporter;
+struct FileManager;
+
 struct ParserError {
     std::string file;
     Span        span;
     std::string error;
 
-    void print_error_message();
+    void print_error_message(FileManager *file_manager);
 };
 
 struct TypeCheckerError {
@@ -28,29 +31,29 @@ struct TypeCheckerError {
     TypeCheckerError       &set_type_expr_1(TypeExpression *type_expression);
     TypeCheckerError       &set_type_expr_2(TypeExpression *type_expression);
     TypeCheckerError       &set_message(std::string message);
-    void                    report();
+    void                    report(ErrorReporter *error_reporter);
 
-    void print_error_message();
+    void print_error_message(FileManager *file_manager);
 };
 
+// owned by the Compiler that is running, every phase that can report errors
+// is given a pointer to it so multiple compilers can run side by side
 struct ErrorReporter {
-    static ErrorReporter         *singleton;
     std::vector<ParserError>      parse_errors;
     std::vector<TypeCheckerError> type_check_errors;
     u64                           errors_since_last_check;
 
     ErrorReporter();
 
-    static void report_parser_error(std::string file, Span span, std::string message);
-    static void report_type_checker_error(std::string file, Expression *expr_1, Expression *expr_2,
-                                          TypeExpression *type_expr_1, TypeExpression *type_expr_2,
-                                          std::string message);
-    static void report_type_checker_error(TypeCheckerError error);
-    static bool has_parse_errors();
-    static bool has_type_check_errors();
-    static bool has_error_since_last_check();
-    static void reset_errors();
-    static u64  error_count();
+    void report_parser_error(std::string file, Span span, std::string message);
+    void report_type_checker_error(std::string file, Expression *expr_1, Expression *expr_2,
+                                   TypeExpression *type_expr_1, TypeExpression *type_expr_2, std::string message);
+    void report_type_checker_error(TypeCheckerError error);
+    bool has_parse_errors();
+    bool has_type_check_errors();
+    bool has_error_since_last_check();
+    void reset_errors();
+    u64  error_count();
 };
 
-void write_error_annotation_at_span(std::string *file, Span span);
+void write_error_annotation_at_span(FileManager *file_manager, std::string *file, Span span);
@@ -7,21 +7,11 @@
 #include <fstream>
 #include <vector>
 
-FileManager *FileManager::singleton = NULL;
-
 Option<FileData *> FileManager::load_relative_from_cwd(std::string path) {
-    if (FileManager::singleton == NULL) {
-        singleton = new FileManager();
-    }
-
-    return singleton->load_relative_to(std::filesystem::current_path().string(), path);
+    return this->load_relative_to(std::filesystem::current_path().string(), path);
 }
 
 Option<FileData *> FileManager::load_relative_to(std::string relative_to, std::string path) {
-    if (FileManager::singleton == NULL) {
-        singleton = new FileManager();
-    }
-
     std::filesystem::path relative_slash_path = std::filesystem::path(relative_to) / path;
     std::filesystem::path absolute_path       = std::filesystem::weakly_canonical(relative_slash_path);
 
@@ -29,10 +19,10 @@ Option<FileData *> FileManager::load_relative_to(std::string relative_to, std::s
         return Option<FileData *>();
     }
 
-    for (u64 i = 0; i < singleton->files.size(); i++) {
+    for (u64 i = 0; i < this->files.size(); i++) {
 
-        if (singleton->files[i]->absolute_path == absolute_path) {
-            return Option(singleton->files[i]);
+        if (this->files[i]->absolute_path == absolute_path) {
+            return Option(this->files[i]);
         }
     }
 
@@ -75,19 +65,22 @@ Option<FileData *> FileManager::load_relative_to(std::string relative_to, std::s
 
     file.close();
 
-    FileManager::singleton->files.push_back(new FileData{
+    this->files.push_back(new FileData{
         .absolute_path = absolute_path, .data = data, .data_length = file_size_in_bytes, .line_count = line_count});
-    return Option(singleton->files.back());
+    return Option(this->files.back());
 }
 
 std::vector<FileData *> *FileManager::get_files() {
-    if (FileManager::singleton == NULL) {
-        singleton = new FileManager();
-    }
-
-    return &singleton->files;
+    return &this->files;
 }
 
 FileManager::FileManager() {
     this->files = std::vector<FileData *>();
 }
+
+FileManager::~FileManager() {
+    for (FileData *file_data : this->files) {
+        free(file_data->data);
+        delete file_data;
+    }
+}
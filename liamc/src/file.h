@@ -17,15 +17,18 @@ struct FileData {
 };
 
 struct FileManager {
-    static FileManager *singleton;
     // heap allocated because then we can append to this
     // list without worry of the ponters being invalidated
     std::vector<FileData *> files;
 
-    static Option<FileData *>       load_relative_from_cwd(std::string path);
-    static Option<FileData *>       load_relative_to(std::string relative_to, std::string path);
-    static std::vector<FileData *> *get_files();
-
-  private:
     FileManager();
+    ~FileManager();
+
+    // the files are freed by the destructor so a copy would free them twice
+    FileManager(const FileManager &)            = delete;
+    FileManager &operator=(const FileManager &) = delete;
+
+    Option<FileData *>       load_relative_from_cwd(std::string path);
+    Option<FileData *>       load_relative_to(std::string relative_to, std::string path);
+    std::vector<FileData *> *get_files();
 };
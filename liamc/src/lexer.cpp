@@ -98,6 +98,9 @@ CompilationUnit *Lexer::lex() {
         case '.':
             this->token_buffer.emplace_back(TokenType::TOKEN_DOT, this->current_index, this->current_index);
             break;
+        case '#':
+            this->token_buffer.emplace_back(TokenType::TOKEN_HASH, this->current_index, this->current_index);
+            break;
         case '<':
             if (peek() == '=') {
                 next_char();
@@ -282,6 +285,17 @@ CompilationUnit *Lexer::lex() {
                 continue;
             }
 
+            if (compare_string(word, "arena_slice")) {
+                this->token_buffer.emplace_back(TokenType::TOKEN_ARENA_SLICE, word_start,
+                                                (word_start - 1) + word.length());
+                continue;
+            }
+
+            if (compare_string(word, "embed")) {
+                this->token_buffer.emplace_back(TokenType::TOKEN_EMBED, word_start, (word_start - 1) + word.length());
+                continue;
+            }
+
             // must be an identifier
             this->token_buffer.emplace_back(TokenType::TOKEN_IDENTIFIER, word_start, (word_start - 1) + word.length());
         } break;
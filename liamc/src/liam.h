@@ -15,11 +15,11 @@ void panic(const std::string &msg);
 
 #define TIME_START(name) auto name = std::chrono::high_resolution_clock::now();
 
-#define TIME_END(name, message)                                                                                        \
+#define TIME_END(name, message, print)                                                                                 \
     {                                                                                                                  \
         auto                                      end   = std::chrono::high_resolution_clock::now();                   \
         std::chrono::duration<double, std::milli> delta = end - name;                                                  \
-        if (args->value<bool>("time")) {                                                                               \
+        if (print) {                                                                                                   \
             std::cout << message << " :: " << delta.count() << "ms\n";                                                 \
         }                                                                                                              \
     }
@@ -50,7 +50,7 @@ void panic(const std::string &msg);
 #define TRY_CALL_RET(func)                                                                                             \
     func;                                                                                                              \
     {                                                                                                                  \
-        if (ErrorReporter::has_error_since_last_check()) {                                                             \
+        if (this->error_reporter->has_error_since_last_check()) {                                                      \
             return {};                                                                                                 \
         }                                                                                                              \
     }
@@ -59,7 +59,7 @@ void panic(const std::string &msg);
 #define TRY_CALL_VOID(func)                                                                                            \
     func;                                                                                                              \
     {                                                                                                                  \
-        if (ErrorReporter::has_error_since_last_check()) {                                                             \
+        if (this->error_reporter->has_error_since_last_check()) {                                                      \
             return;                                                                                                    \
         }                                                                                                              \
     }
@@ -1,54 +1,54 @@
 #include <chrono>
-#include <filesystem>
+#include <fstream>
 #include <iostream>
-#include <vector>
 
 #include "args.h"
-#include "compilation_unit.h"
-#include "cpp_backend.h"
-#include "errors.h"
-#include "file.h"
-#include "lexer.h"
+#include "compiler.h"
 #include "liam.h"
-#include "parser.h"
-#include "type_checker.h"
-
-CompilationBundle lex_parse();
-void              type_check(CompilationBundle *file);
-std::string       code_gen(CompilationBundle *file);
 
 i32 main(i32 argc, char **argv) {
     TIME_START(total_time);
 
-    Arguments::make(argc, argv);
+    Arguments *arguments = Arguments::make(argc, argv);
+
+    if (arguments->help) {
+        std::cout << arguments->help_text() << std::endl;
+        return 0;
+    }
+
+    if (arguments->zen) {
+        std::cout << arguments->zen_text() << std::endl;
+        return 0;
+    }
+
+    if (!arguments->error.empty()) {
+        panic(arguments->error);
+    }
+
+    Compiler compiler(arguments);
 
-    std::string in = args->files[0];
+    Option<std::string> code = compiler.compile();
 
-    TIME_START(lex_parse_time);
-    CompilationBundle bundle = lex_parse();
-    TIME_END(lex_parse_time, "Lex and parsing time");
-    TIME_START(type_time);
-    type_check(&bundle);
-    TIME_END(type_time, "Type checking time");
+    // written before errors are handled so failed compilations can be looked at too
+    if (!compiler.write_trace()) {
+        std::cout << "Cannot write trace to " << arguments->trace_path << "\n";
+    }
 
-    TIME_START(code_gen_time);
-    auto code = code_gen(&bundle);
-    TIME_END(code_gen_time, "Code generation time");
+    if (!code.is_some()) {
+        compiler.print_errors();
+        panic("Cannot continue with errors :: count (" + std::to_string(compiler.error_reporter.error_count()) + ")");
+    }
 
     std::ofstream out_file;
-    out_file = std::ofstream(args->out_path);
+    out_file = std::ofstream(arguments->out_path);
 
-    out_file << code;
+    out_file << code.value();
     out_file.close();
 
-    TIME_END(total_time, "Total compile time");
-
-    if (args->time) {
-        u64 total_line_count = 0;
-        for (auto &file_data : *FileManager::get_files()) {
-            total_line_count += file_data->line_count;
-        }
+    TIME_END(total_time, "Total compile time", arguments->time);
 
+    if (arguments->time) {
+        u64 total_line_count           = compiler.total_line_count();
         u64 total_time_in_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
                                              std::chrono::high_resolution_clock::now() - total_time)
                                              .count();
@@ -57,53 +57,9 @@ i32 main(i32 argc, char **argv) {
                   << " :: LOC/s :: " << (f64)total_line_count / ((f64)total_time_in_milliseconds / 1000.0) << "\n";
     }
 
-    if (args->emit) {
-        std::cout << code << "\n";
+    if (arguments->emit) {
+        std::cout << code.value() << "\n";
     }
 
     return 0;
 }
-
-CompilationBundle lex_parse() {
-
-    std::vector<CompilationUnit *> compilation_units;
-
-    for (auto &input_file : args->files) {
-        std::filesystem::path file_path        = std::filesystem::path(input_file);
-        FileData             *file_data        = FileManager::load_relative_from_cwd(file_path.string()).value();
-        Lexer                 lexer            = Lexer(file_data);
-        CompilationUnit      *compilation_unit = lexer.lex();
-        Parser                parser           = Parser(compilation_unit);
-        parser.parse();
-        compilation_units.push_back(parser.compilation_unit);
-    }
-
-    if (ErrorReporter::has_parse_errors()) {
-        for (auto &error : ErrorReporter::singleton->parse_errors) {
-            error.print_error_message();
-        }
-
-        panic("Cannot continue with errors :: count (" + std::to_string(ErrorReporter::singleton->parse_errors.size()) +
-              ")");
-    }
-
-    return CompilationBundle(compilation_units);
-}
-
-void type_check(CompilationBundle *bundle) {
-    TypeChecker type_checker = TypeChecker();
-    type_checker.type_check(bundle);
-
-    if (ErrorReporter::has_type_check_errors()) {
-        for (auto &error : ErrorReporter::singleton->type_check_errors) {
-            error.print_error_message();
-        }
-
-        panic("Cannot continue with errors :: count (" +
-              std::to_string(ErrorReporter::singleton->type_check_errors.size()) + ")");
-    }
-}
-
-std::string code_gen(CompilationBundle *bundle) {
-    return CppBackend().emit(bundle);
-}
@@ -0,0 +1,250 @@
+#include "mem_stats.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+u64 peak_rss_bytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+
+    return counters.PeakWorkingSetSize;
+#elif defined(__linux__)
+    // ru_maxrss is carried over exec on linux so a child of a big process would report
+    // the parents peak, the high water mark in /proc is only ever for this process
+    std::ifstream status = std::ifstream("/proc/self/status");
+    std::string   line;
+    while (std::getline(status, line)) {
+        if (line.starts_with("VmHWM:")) {
+            return std::stoull(line.substr(6)) * 1024;
+        }
+    }
+
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+
+#if defined(__APPLE__)
+    // bytes on mac but kilobytes everywhere else
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+std::string format_bytes(u64 bytes) {
+    if (bytes < 1024) {
+        return std::format("{}B", bytes);
+    }
+
+    if (bytes < 1024 * 1024) {
+        return std::format("{:.1f}KB", (double)bytes / 1024.0);
+    }
+
+    return std::format("{:.1f}MB", (double)bytes / (1024.0 * 1024.0));
+}
+
+std::string statement_type_name(StatementType type) {
+    switch (type) {
+    case StatementType::EXPRESSION:
+        return "expression";
+    case StatementType::LET:
+        return "let";
+    case StatementType::SCOPE:
+        return "scope";
+    case StatementType::FN:
+        return "fn";
+    case StatementType::STRUCT:
+        return "struct";
+    case StatementType::ASSIGNMENT:
+        return "assignment";
+    case StatementType::RETURN:
+        return "return";
+    case StatementType::BREAK:
+        return "break";
+    case StatementType::FOR:
+        return "for";
+    case StatementType::IF:
+        return "if";
+    case StatementType::ELSE:
+        return "else";
+    case StatementType::CONTINUE:
+        return "continue";
+    case StatementType::IMPORT:
+        return "import";
+    case StatementType::PRINT:
+        return "print";
+    case StatementType::ASSERT:
+        return "assert";
+    case StatementType::WHILE:
+        return "while";
+    default:
+        return "undefined";
+    }
+}
+
+std::string expression_type_name(ExpressionType type) {
+    switch (type) {
+    case ExpressionType::BINARY:
+        return "binary";
+    case ExpressionType::UNARY:
+        return "unary";
+    case ExpressionType::SUBSCRIPT:
+        return "subscript";
+    case ExpressionType::NUMBER_LITERAL:
+        return "number literal";
+    case ExpressionType::STRING_LITERAL:
+        return "string literal";
+    case ExpressionType::BOOL_LITERAL:
+        return "bool literal";
+    case ExpressionType::IDENTIFIER:
+        return "identifier";
+    case ExpressionType::CALL:
+        return "call";
+    case ExpressionType::GET:
+        return "get";
+    case ExpressionType::GROUP:
+        return "group";
+    case ExpressionType::NULL_LITERAL:
+        return "null literal";
+    case ExpressionType::ZERO_LITERAL:
+        return "zero literal";
+    case ExpressionType::INSTANTIATION:
+        return "instantiation";
+    case ExpressionType::STRUCT_INSTANCE:
+        return "struct instance";
+    case ExpressionType::STATIC_ARRAY:
+        return "static array";
+    case ExpressionType::RANGE:
+        return "range";
+    case ExpressionType::ARENA_SLICE:
+        return "arena slice";
+    case ExpressionType::EMBED:
+        return "embed";
+    default:
+        return "undefined";
+    }
+}
+
+std::string type_expression_type_name(TypeExpressionType type) {
+    switch (type) {
+    case TypeExpressionType::TYPE_IDENTIFIER:
+        return "identifier";
+    case TypeExpressionType::TYPE_UNARY:
+        return "unary";
+    case TypeExpressionType::TYPE_GET:
+        return "get";
+    case TypeExpressionType::TYPE_STATIC_ARRAY:
+        return "static array";
+    case TypeExpressionType::TYPE_SLICE:
+        return "slice";
+    case TypeExpressionType::TYPE_POOL:
+        return "pool";
+    case TypeExpressionType::TYPE_DYNAMIC_ARRAY:
+        return "dynamic array";
+    case TypeExpressionType::TYPE_HASH_MAP:
+        return "hash map";
+    default:
+        return "undefined";
+    }
+}
+
+std::string type_info_type_name(TypeInfoType type) {
+    switch (type) {
+    case TypeInfoType::ANY:
+        return "any";
+    case TypeInfoType::VOID:
+        return "void";
+    case TypeInfoType::NUMBER:
+        return "number";
+    case TypeInfoType::BOOLEAN:
+        return "bool";
+    case TypeInfoType::STRING:
+        return "string";
+    case TypeInfoType::FN:
+        return "fn";
+    case TypeInfoType::STRUCT:
+        return "struct";
+    case TypeInfoType::POINTER:
+        return "pointer";
+    case TypeInfoType::NAMESPACE:
+        return "namespace";
+    case TypeInfoType::STATIC_ARRAY:
+        return "static array";
+    case TypeInfoType::SLICE:
+        return "slice";
+    case TypeInfoType::RANGE:
+        return "range";
+    case TypeInfoType::VECTOR:
+        return "vector";
+    case TypeInfoType::TYPE:
+        return "type";
+    case TypeInfoType::ARENA:
+        return "arena";
+    case TypeInfoType::POOL:
+        return "pool";
+    case TypeInfoType::DYNAMIC_ARRAY:
+        return "dynamic array";
+    case TypeInfoType::HASH_MAP:
+        return "hash map";
+    default:
+        return "undefined";
+    }
+}
+
+void print_mem_stats_line(std::string name, u64 count, u64 bytes) {
+    std::cout << std::format("    {:<28} :: {:>10} :: {:>10}\n", name, count, format_bytes(bytes));
+}
+
+// the maps are unordered so the kinds are sorted to print them in the order of their enum
+template <typename T>
+void print_mem_stats_kinds(std::string prefix, std::unordered_map<T, u64> &counts, std::unordered_map<T, u64> &bytes,
+                           std::string (*name)(T)) {
+    std::vector<T> kinds;
+    for (auto &[kind, _] : counts) {
+        kinds.push_back(kind);
+    }
+
+    std::sort(kinds.begin(), kinds.end());
+    for (T kind : kinds) {
+        print_mem_stats_line(prefix + " " + name(kind), counts[kind], bytes[kind]);
+    }
+}
+
+void print_mem_stats(std::string phase, AstStats *stats, u64 builder_bytes) {
+    std::cout << "Memory after " << phase << " :: peak rss :: " << format_bytes(peak_rss_bytes()) << "\n";
+
+    print_mem_stats_line("tokens", stats->token_count, stats->token_bytes);
+    print_mem_stats_line("ast nodes", stats->ast_node_count(), stats->ast_node_bytes());
+    print_mem_stats_kinds("statement", stats->statement_counts, stats->statement_bytes, statement_type_name);
+    print_mem_stats_kinds("expression", stats->expression_counts, stats->expression_bytes, expression_type_name);
+    print_mem_stats_kinds("type expression", stats->type_expression_counts, stats->type_expression_bytes,
+                          type_expression_type_name);
+
+    u64 type_info_bytes = 0;
+    for (auto &[_, n] : stats->type_info_bytes) {
+        type_info_bytes += n;
+    }
+
+    print_mem_stats_line("type infos", stats->type_infos.size(), type_info_bytes);
+    print_mem_stats_kinds("type info", stats->type_info_counts, stats->type_info_bytes, type_info_type_name);
+    print_mem_stats_line("scope entries", stats->scope_entry_count, stats->scope_bytes);
+    print_mem_stats_line("builder output", builder_bytes, builder_bytes);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+#include "ast_stats.h"
+#include "baseLayer/types.h"
+
+// the most memory the process has had resident at once, 0 if the
+// platform gives no way of finding this out
+u64 peak_rss_bytes();
+
+// prints how much memory each category of object is using once a phase
+// is done, builder_bytes is the size of the generated c++ so far
+void print_mem_stats(std::string phase, AstStats *stats, u64 builder_bytes);
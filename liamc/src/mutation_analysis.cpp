@@ -0,0 +1,283 @@
+#include "mutation_analysis.h"
+
+#include "baseLayer/debug.h"
+
+MutationAnalysis::MutationAnalysis(CompilationUnit *compilation_unit, std::vector<std::string> watched) {
+    this->compilation_unit      = compilation_unit;
+    this->watched               = watched;
+    this->ignore_element_writes = false;
+    this->track_copies          = false;
+}
+
+bool MutationAnalysis::might_mutate_statement(Statement *statement) {
+    if (statement == NULL) {
+        return false;
+    }
+
+    switch (statement->statement_type) {
+    case StatementType::EXPRESSION:
+        return might_mutate_expression(static_cast<ExpressionStatement *>(statement)->expression);
+    case StatementType::LET: {
+        auto let_statement = static_cast<LetStatement *>(statement);
+        return is_copied(let_statement->rhs) || might_mutate_expression(let_statement->rhs);
+    }
+    case StatementType::SCOPE: {
+        for (auto stmt : static_cast<ScopeStatement *>(statement)->statements) {
+            if (might_mutate_statement(stmt)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+    case StatementType::ASSIGNMENT: {
+        auto assigment_statement = static_cast<AssigmentStatement *>(statement);
+        if (this->track_copies) {
+            return is_watched(assigment_statement->lhs) || might_mutate_expression(assigment_statement->lhs) ||
+                   is_copied(assigment_statement->assigned_to->expression) ||
+                   might_mutate_statement(assigment_statement->assigned_to);
+        }
+
+        if (this->ignore_element_writes && is_element_write(assigment_statement->lhs)) {
+            return might_mutate_expression(assigment_statement->lhs) ||
+                   might_mutate_statement(assigment_statement->assigned_to);
+        }
+
+        if (assigment_statement->lhs->type != ExpressionType::IDENTIFIER || is_watched(assigment_statement->lhs)) {
+            return true;
+        }
+
+        return might_mutate_statement(assigment_statement->assigned_to);
+    }
+    case StatementType::RETURN: {
+        auto return_statement = static_cast<ReturnStatement *>(statement);
+        return is_copied(return_statement->expression) || might_mutate_expression(return_statement->expression);
+    }
+    case StatementType::FOR: {
+        // for ^v : values can write to the values through v
+        auto for_statement = static_cast<ForStatement *>(statement);
+        if (for_statement->value_is_pointer && !this->ignore_element_writes && is_watched(for_statement->expression)) {
+            return true;
+        }
+
+        return might_mutate_expression(for_statement->expression) || might_mutate_expression(for_statement->grain) ||
+               might_mutate_statement(for_statement->body);
+    }
+    case StatementType::IF: {
+        auto if_statement = static_cast<IfStatement *>(statement);
+        return might_mutate_expression(if_statement->expression) || might_mutate_statement(if_statement->body) ||
+               might_mutate_statement(if_statement->else_statement);
+    }
+    case StatementType::ELSE: {
+        auto else_statement = static_cast<ElseStatement *>(statement);
+        return might_mutate_statement(else_statement->if_statement) || might_mutate_statement(else_statement->body);
+    }
+    case StatementType::PRINT:
+        return might_mutate_expression(static_cast<PrintStatement *>(statement)->expression);
+    case StatementType::ASSERT:
+        return might_mutate_expression(static_cast<AssertStatement *>(statement)->expression);
+    case StatementType::WHILE: {
+        auto while_statement = static_cast<WhileStatement *>(statement);
+        return might_mutate_expression(while_statement->expression) || might_mutate_statement(while_statement->body);
+    }
+    case StatementType::BREAK:
+    case StatementType::CONTINUE:
+        return false;
+    default:
+        // anything new is a change until it is handled here
+        return true;
+    }
+}
+
+bool MutationAnalysis::might_mutate_expression(Expression *expression) {
+    if (expression == NULL) {
+        return false;
+    }
+
+    switch (expression->type) {
+    case ExpressionType::BINARY: {
+        auto binary_expression = static_cast<BinaryExpression *>(expression);
+        return might_mutate_expression(binary_expression->left) || might_mutate_expression(binary_expression->right);
+    }
+    case ExpressionType::UNARY: {
+        auto unary_expression = static_cast<UnaryExpression *>(expression);
+        if (unary_expression->unary_type == UnaryType::POINTER && is_watched(unary_expression->expression)) {
+            return true;
+        }
+
+        return might_mutate_expression(unary_expression->expression);
+    }
+    case ExpressionType::SUBSCRIPT: {
+        auto subscript_expression = static_cast<SubscriptExpression *>(expression);
+        return might_mutate_expression(subscript_expression->subscriptee) ||
+               might_mutate_expression(subscript_expression->subscripter);
+    }
+    case ExpressionType::CALL: {
+        auto call_expression = static_cast<CallExpression *>(expression);
+        for (auto arg : call_expression->args) {
+            // the fn gets a copy of a slice of numbers so it can only change the elements
+            bool is_element_slice = this->ignore_element_writes && arg->type_info->type == TypeInfoType::SLICE &&
+                                    !holds_pointer(static_cast<SliceTypeInfo *>(arg->type_info)->base_type);
+            if (this->track_copies ? is_copied(arg) : !is_element_slice && holds_pointer(arg->type_info)) {
+                return true;
+            }
+
+            if (might_mutate_expression(arg)) {
+                return true;
+            }
+        }
+
+        // arena.reset(), pool.free(p), array.push(v) and map.insert(k, v) change what they are
+        // called on, map.find(k) gives a pointer into the map so it is counted as well. Called
+        // through a pointer they can change whatever it points to
+        if (call_expression->callee->type == ExpressionType::GET) {
+            Expression  *lhs      = static_cast<GetExpression *>(call_expression->callee)->lhs;
+            TypeInfoType lhs_type = lhs->type_info->type;
+            if ((lhs_type == TypeInfoType::ARENA || lhs_type == TypeInfoType::POOL ||
+                 lhs_type == TypeInfoType::DYNAMIC_ARRAY || lhs_type == TypeInfoType::HASH_MAP) &&
+                is_watched(lhs)) {
+                return true;
+            }
+
+            if (lhs_type == TypeInfoType::POINTER && (!this->track_copies || is_watched(lhs))) {
+                return true;
+            }
+        }
+
+        return might_mutate_expression(call_expression->callee);
+    }
+    case ExpressionType::GET:
+        return might_mutate_expression(static_cast<GetExpression *>(expression)->lhs);
+    case ExpressionType::GROUP:
+        return might_mutate_expression(static_cast<GroupExpression *>(expression)->sub_expression);
+    case ExpressionType::INSTANTIATION:
+        return might_mutate_expression(static_cast<InstantiateExpression *>(expression)->expression);
+    case ExpressionType::STRUCT_INSTANCE: {
+        auto struct_instance_expression = static_cast<StructInstanceExpression *>(expression);
+        for (auto &[_, expr] : struct_instance_expression->named_expressions) {
+            if (is_copied(expr) || might_mutate_expression(expr)) {
+                return true;
+            }
+        }
+
+        // new(arena) T{...} allocates from the arena
+        if (struct_instance_expression->allocator != NULL) {
+            return is_watched(struct_instance_expression->allocator) ||
+                   might_mutate_expression(struct_instance_expression->allocator);
+        }
+
+        return false;
+    }
+    case ExpressionType::STATIC_ARRAY: {
+        for (auto expr : static_cast<StaticArrayExpression *>(expression)->expressions) {
+            if (is_copied(expr) || might_mutate_expression(expr)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+    case ExpressionType::RANGE: {
+        auto range_expression = static_cast<RangeExpression *>(expression);
+        return might_mutate_expression(range_expression->start) || might_mutate_expression(range_expression->end);
+    }
+    case ExpressionType::ARENA_SLICE: {
+        auto arena_slice_expression = static_cast<ArenaSliceExpression *>(expression);
+        return is_watched(arena_slice_expression->arena) || might_mutate_expression(arena_slice_expression->arena) ||
+               might_mutate_expression(arena_slice_expression->count);
+    }
+    case ExpressionType::NUMBER_LITERAL:
+    case ExpressionType::STRING_LITERAL:
+    case ExpressionType::BOOL_LITERAL:
+    case ExpressionType::IDENTIFIER:
+    case ExpressionType::NULL_LITERAL:
+    case ExpressionType::ZERO_LITERAL:
+    case ExpressionType::EMBED:
+        return false;
+    default:
+        return true;
+    }
+}
+
+bool MutationAnalysis::is_watched(Expression *expression) {
+    IdentifierExpression *identifier_expression = root_identifier(expression);
+    if (identifier_expression == NULL) {
+        return false;
+    }
+
+    std::string identifier = this->compilation_unit->get_token_string_from_index(identifier_expression->identifier);
+    for (auto &watched_identifier : this->watched) {
+        if (watched_identifier == identifier) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool MutationAnalysis::is_element_write(Expression *expression) {
+    // s[i] = ... writes into an element of some array, which is never a watched
+    // number or slice on its own. Static and dynamic arrays hold their elements
+    // so writing to one changes it
+    if (expression->type != ExpressionType::SUBSCRIPT) {
+        return false;
+    }
+
+    TypeInfoType subscriptee_type = static_cast<SubscriptExpression *>(expression)->subscriptee->type_info->type;
+    if (subscriptee_type == TypeInfoType::STATIC_ARRAY || subscriptee_type == TypeInfoType::DYNAMIC_ARRAY) {
+        return !is_watched(expression);
+    }
+
+    return subscriptee_type == TypeInfoType::SLICE;
+}
+
+bool MutationAnalysis::is_copied(Expression *expression) {
+    // let t : []u8 = s[{1:}] --> a copy of s that can be written through
+    return this->track_copies && expression != NULL && holds_pointer(expression->type_info) && is_watched(expression);
+}
+
+bool holds_pointer(TypeInfo *type_info) {
+    switch (type_info->type) {
+    case TypeInfoType::POINTER:
+    case TypeInfoType::SLICE:
+    case TypeInfoType::DYNAMIC_ARRAY:
+    case TypeInfoType::HASH_MAP:
+        return true;
+    case TypeInfoType::STATIC_ARRAY:
+        return holds_pointer(static_cast<StaticArrayTypeInfo *>(type_info)->base_type);
+    case TypeInfoType::STRUCT: {
+        // structs cannot hold themselves other than through a pointer so this ends
+        for (auto &[_, member_type_info] : static_cast<StructTypeInfo *>(type_info)->members) {
+            if (holds_pointer(member_type_info)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+    default:
+        return false;
+    }
+}
+
+IdentifierExpression *root_identifier(Expression *expression) {
+    while (expression != NULL) {
+        switch (expression->type) {
+        case ExpressionType::IDENTIFIER:
+            return static_cast<IdentifierExpression *>(expression);
+        case ExpressionType::GET:
+            expression = static_cast<GetExpression *>(expression)->lhs;
+            break;
+        case ExpressionType::SUBSCRIPT:
+            expression = static_cast<SubscriptExpression *>(expression)->subscriptee;
+            break;
+        case ExpressionType::GROUP:
+            expression = static_cast<GroupExpression *>(expression)->sub_expression;
+            break;
+        default:
+            return NULL;
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ast.h"
+#include "compilation_unit.h"
+
+// Finds out if a block of code might change the values of some identifiers, this
+// is used so the backend can use references instead of copies when it is safe.
+// It is conservative so anything it is not sure about counts as a change:
+//      assigning to a watched identifier
+//      assigning through anything other than a plain identifier, i.e. a.x = 1,
+//      a[0] = 1 or *p = 1, as it could be writing to memory a watched value uses
+//      taking the address of a watched identifier or any part of it
+//      calling a fn with anything that holds a pointer, like a struct with a
+//      pointer member, as it could write through them
+// When only numbers and slices are watched and not what the slices point to,
+// writes to elements of arrays and slices and passing slices of numbers can be ignored.
+// When tracking copies only changes made through the watched values count, and instead
+// copying one that holds a pointer anywhere, a let, return or call, counts as a change.
+// Nothing else can then point to the same memory, this keeps slices of embedded files read only
+struct MutationAnalysis {
+    CompilationUnit         *compilation_unit;
+    std::vector<std::string> watched;
+    bool                     ignore_element_writes;
+    bool                     track_copies;
+
+    MutationAnalysis(CompilationUnit *compilation_unit, std::vector<std::string> watched);
+
+    bool might_mutate_statement(Statement *statement);
+    bool might_mutate_expression(Expression *expression);
+    bool is_watched(Expression *expression);
+    bool is_element_write(Expression *expression);
+    bool is_copied(Expression *expression);
+};
+
+// if a copy of a value of this type can still be used to change other values, pointers
+// and slices or anything holding one. Dynamic arrays and maps count as they can hold an arena
+bool holds_pointer(TypeInfo *type_info);
+
+// the identifier an lvalue is part of e.g. a.b[0].c --> a, NULL if
+// it is not part of one like a call or literal
+IdentifierExpression *root_identifier(Expression *expression);
@@ -1,5 +1,6 @@
 #include "parser.h"
 
+#include <charconv>
 #include <format>
 #include <set>
 #include <tuple>
@@ -12,16 +13,24 @@
 #include "liam.h"
 #include "token.h"
 
-Parser::Parser(CompilationUnit *compilation_unit) {
+// which tags mean something on each thing they can be put on
+static const u16 STRUCT_TAGS = TAG_ALIGN | TAG_PACKED;
+static const u16 FN_TAGS     = TAG_INLINE | TAG_NOINLINE | TAG_HOT | TAG_COLD | TAG_FLATTEN;
+static const u16 PARAM_TAGS  = TAG_NOALIAS;
+static const u16 BRANCH_TAGS = TAG_LIKELY | TAG_UNLIKELY;
+static const u16 LOOP_TAGS   = TAG_SIMD;
+
+Parser::Parser(CompilationUnit *compilation_unit, ErrorReporter *error_reporter) {
     this->compilation_unit = compilation_unit;
+    this->error_reporter   = error_reporter;
     this->current          = 0;
 }
 
 void Parser::parse() {
     while (current < this->compilation_unit->token_buffer.size()) {
-        auto errors_before = ErrorReporter::error_count();
+        auto errors_before = this->error_reporter->error_count();
         auto stmt          = TRY_CALL_VOID(eval_top_level_statement());
-        if (ErrorReporter::error_count() > errors_before)
+        if (this->error_reporter->error_count() > errors_before)
             continue;
 
         if (stmt->statement_type == StatementType::FN) {
@@ -71,7 +80,7 @@ Statement *Parser::eval_statement() {
     case TokenType::TOKEN_FN:
     case TokenType::TOKEN_STRUCT:
     case TokenType::TOKEN_IMPORT: {
-        ErrorReporter::report_parser_error(
+        this->error_reporter->report_parser_error(
             this->compilation_unit->file_data->absolute_path.string(), peek()->span,
             std::format("unexpected token used to declare new statement in scope '{}'",
                         this->compilation_unit->get_token_string_from_index(consume_token_with_index())));
@@ -90,13 +99,32 @@ Statement *Parser::eval_top_level_statement() {
     case TokenType::TOKEN_STRUCT:
         return eval_struct_statement();
         break;
+    case TokenType::TOKEN_HASH: {
+        // #align(64) struct Foo { ... } or #inline fn foo() ...
+        // what the tags are on is needed to know which are allowed so look past them first
+        u64 offset = 0;
+        while (this->current + offset < this->compilation_unit->token_buffer.size() &&
+               peek(offset)->token_type != TokenType::TOKEN_FN &&
+               peek(offset)->token_type != TokenType::TOKEN_STRUCT) {
+            offset++;
+        }
+
+        if (this->current + offset < this->compilation_unit->token_buffer.size() &&
+            peek(offset)->token_type == TokenType::TOKEN_FN) {
+            Tags tags = TRY_CALL_RET(consume_tags(FN_TAGS));
+            return eval_fn_statement(tags);
+        }
+
+        Tags tags = TRY_CALL_RET(consume_tags(STRUCT_TAGS));
+        return eval_struct_statement(tags);
+    } break;
     case TokenType::TOKEN_IMPORT:
         return eval_import_statement();
         break;
     default: {
         auto token      = consume_token_with_index();
         auto token_data = this->compilation_unit->get_token(token);
-        ErrorReporter::report_parser_error(
+        this->error_reporter->report_parser_error(
             this->compilation_unit->file_data->absolute_path.string(), token_data->span,
             std::format("Unexpected token used to declare new statement at top level '{}'",
                         this->compilation_unit->get_token_string_from_index(token)));
@@ -128,8 +156,8 @@ ScopeStatement *Parser::eval_scope_statement() {
         find_balance_point(TokenType::TOKEN_BRACE_OPEN, TokenType::TOKEN_BRACE_CLOSE, this->current - 1);
 
     if (!closing_brace_index.is_some()) {
-        ErrorReporter::report_parser_error(this->compilation_unit->file_data->absolute_path.string(),
-                                           open_brace_token_data->span, "No closing brace for scope found");
+        this->error_reporter->report_parser_error(this->compilation_unit->file_data->absolute_path.string(),
+                                                  open_brace_token_data->span, "No closing brace for scope found");
         return NULL;
     }
 
@@ -142,32 +170,49 @@ ScopeStatement *Parser::eval_scope_statement() {
     return new ScopeStatement(statements);
 }
 
-FnStatement *Parser::eval_fn_statement() {
-    TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_FN));
-
+FnStatement *Parser::eval_fn_statement(Tags tags) {
+    auto fn_token   = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_FN));
     auto identifier = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_IDENTIFIER));
 
+    // fn max[T](a: T, b: T) T { ... }
+    auto generic_params = std::vector<TokenIndex>();
+    if (match(TokenType::TOKEN_BRACKET_OPEN)) {
+        consume_token_with_index();
+        do {
+            if (!generic_params.empty()) {
+                consume_token_with_index();
+            }
+
+            auto generic_param = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_IDENTIFIER));
+            generic_params.push_back(generic_param);
+        } while (match(TokenType::TOKEN_COMMA));
+        TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACKET_CLOSE));
+    }
+
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_PAREN_OPEN));
 
-    auto params = TRY_CALL_RET(consume_comma_seperated_params());
+    auto param_tags = std::vector<Tags>();
+    auto params     = TRY_CALL_RET(consume_comma_seperated_params(&param_tags, PARAM_TAGS));
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_PAREN_CLOSE));
 
     auto type = TRY_CALL_RET(eval_type_expression());
 
     auto body = TRY_CALL_RET(eval_scope_statement());
-    return new FnStatement(this->compilation_unit, identifier, params, type, body);
+    return new FnStatement(this->compilation_unit, identifier, params, type, body, tags, param_tags, fn_token,
+                           generic_params);
 }
 
-StructStatement *Parser::eval_struct_statement() {
+StructStatement *Parser::eval_struct_statement(Tags tags) {
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_STRUCT));
 
     auto identifier = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_IDENTIFIER));
 
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACE_OPEN));
 
-    auto member = TRY_CALL_RET(consume_comma_seperated_params());
+    auto member_tags = std::vector<Tags>();
+    auto member      = TRY_CALL_RET(consume_comma_seperated_params(&member_tags, STRUCT_TAGS));
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACE_CLOSE));
-    return new StructStatement(this->compilation_unit, identifier, member, NULL);
+    return new StructStatement(this->compilation_unit, identifier, member, NULL, tags, member_tags);
 }
 
 ReturnStatement *Parser::eval_return_statement() {
@@ -194,17 +239,48 @@ BreakStatement *Parser::eval_break_statement() {
 
 ForStatement *Parser::eval_for_statement() {
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_FOR));
+
+    // for par value : array { ... } runs the iterations across threads, par is not a
+    // keyword so for par : array { ... } still uses par as the value identifier
+    bool        is_parallel = false;
+    Expression *grain       = NULL;
+    if (peek()->token_type == TokenType::TOKEN_IDENTIFIER &&
+        this->compilation_unit->get_token_string_from_index(this->current) == "par" &&
+        peek(1)->token_type != TokenType::TOKEN_COLON) {
+        consume_token_with_index();
+        is_parallel = true;
+
+        // for par(64) value : ... sets how many iterations a thread takes at a time
+        if (match(TokenType::TOKEN_PAREN_OPEN)) {
+            consume_token_with_index();
+            grain = TRY_CALL_RET(eval_expression());
+            TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_PAREN_CLOSE));
+        }
+    }
+
+    // for #simd value : array { ... } or for par #simd value : array { ... }
+    Tags tags = TRY_CALL_RET(consume_tags(LOOP_TAGS));
+
+    // for ^value : array { ... } gives a pointer to each value instead of a copy
+    bool value_is_pointer = false;
+    if (match(TokenType::TOKEN_HAT)) {
+        consume_token_with_index();
+        value_is_pointer = true;
+    }
+
     TokenIndex value_identifier = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_IDENTIFIER));
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_COLON));
     Expression     *expression = TRY_CALL_RET(eval_expression());
     ScopeStatement *body       = TRY_CALL_RET(eval_scope_statement());
 
     // the for type is set later on in the type checking phase
-    return new ForStatement(value_identifier, expression, body, ForType::UNDEFINED);
+    return new ForStatement(value_identifier, expression, body, ForType::UNDEFINED, value_is_pointer, is_parallel,
+                            grain, tags);
 }
 
 IfStatement *Parser::eval_if_statement() {
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_IF));
+    auto tags                     = TRY_CALL_RET(consume_tags(BRANCH_TAGS)); // if #unlikely x {
     auto expression               = TRY_CALL_RET(eval_expression());
     auto body                     = TRY_CALL_RET(eval_scope_statement());
 
@@ -215,7 +291,7 @@ IfStatement *Parser::eval_if_statement() {
         else_statement = TRY_CALL_RET(eval_else_statement());
     }
 
-    return new IfStatement(expression, body, else_statement);
+    return new IfStatement(expression, body, else_statement, tags);
 }
 
 ElseStatement *Parser::eval_else_statement() {
@@ -268,9 +344,10 @@ AssertStatement *Parser::eval_assert_statement() {
 
 WhileStatement *Parser::eval_while_statement() {
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_WHILE));
+    Tags            tags       = TRY_CALL_RET(consume_tags(BRANCH_TAGS)); // while #likely x {
     Expression     *expression = TRY_CALL_RET(eval_expression());
     ScopeStatement *body       = TRY_CALL_RET(eval_scope_statement());
-    return new WhileStatement(expression, body);
+    return new WhileStatement(expression, body, tags);
 }
 
 Statement *Parser::eval_line_starting_expression() {
@@ -471,10 +548,16 @@ Expression *Parser::eval_primary() {
     case TokenType::TOKEN_BRACE_OPEN: {
         return TRY_CALL_RET(eval_range_expression());
     } break;
+    case TokenType::TOKEN_ARENA_SLICE: {
+        return TRY_CALL_RET(eval_arena_slice_expression());
+    } break;
+    case TokenType::TOKEN_EMBED: {
+        return TRY_CALL_RET(eval_embed_expression());
+    } break;
     default: {
         auto token_index = consume_token_with_index();
         auto token_data  = this->compilation_unit->get_token(token_index);
-        ErrorReporter::report_parser_error(
+        this->error_reporter->report_parser_error(
             this->compilation_unit->file_data->absolute_path.string(), token_data->span,
             std::format("Unexpected token '{}' when parsing expression",
                         get_token_type_string(this->compilation_unit->get_token(token_index)->token_type)));
@@ -499,13 +582,22 @@ Expression *Parser::eval_string_literal() {
 
 Expression *Parser::eval_struct_instance_expression() {
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_NEW));
+
+    // new(arena) T{...} puts the instance in an arena or pool and gives a pointer to it
+    Expression *allocator = NULL;
+    if (match(TokenType::TOKEN_PAREN_OPEN)) {
+        consume_token_with_index();
+        allocator = TRY_CALL_RET(eval_expression());
+        TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_PAREN_CLOSE));
+    }
+
     TypeExpression *type_expression = TRY_CALL_RET(eval_type_expression());
 
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACE_OPEN));
     auto named_expressions = TRY_CALL_RET(consume_comma_seperated_named_arguments(TokenType::TOKEN_BRACE_CLOSE));
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACE_CLOSE));
 
-    return new StructInstanceExpression(type_expression, named_expressions);
+    return new StructInstanceExpression(type_expression, named_expressions, allocator);
 }
 
 Expression *Parser::eval_group_expression() {
@@ -528,12 +620,43 @@ Expression *Parser::eval_static_array_literal() {
     return new StaticArrayExpression(size, type_expression, expressions);
 }
 
+Expression *Parser::eval_arena_slice_expression() {
+    // arena_slice(arena, T, count)
+    Token *token = peek();
+    TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_ARENA_SLICE));
+    TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_PAREN_OPEN));
+    Expression *arena = TRY_CALL_RET(eval_expression());
+    TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_COMMA));
+    TypeExpression *type_expression = TRY_CALL_RET(eval_type_expression());
+    TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_COMMA));
+    Expression *count = TRY_CALL_RET(eval_expression());
+    TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_PAREN_CLOSE));
+
+    return new ArenaSliceExpression(arena, type_expression, count, token->span);
+}
+
+Expression *Parser::eval_embed_expression() {
+    // embed "file.bin"
+    // embed T "file.bin"
+    Token *token = peek();
+    TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_EMBED));
+
+    TypeExpression *element_type = NULL;
+    if (!match(TokenType::TOKEN_STRING_LITERAL)) {
+        element_type = TRY_CALL_RET(eval_type_expression());
+    }
+
+    TokenIndex path = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_STRING_LITERAL));
+    return new EmbedExpression(path, element_type, token->span);
+}
+
 Expression *Parser::eval_range_expression() {
     // {:}
     // {1:}
     // {:10}
 
-    TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACE_OPEN));
+    // either side might be missing so the span goes from { to }
+    TokenIndex open_token = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACE_OPEN));
 
     Expression *start = NULL;
     Expression *end   = NULL;
@@ -548,9 +671,11 @@ Expression *Parser::eval_range_expression() {
         end = TRY_CALL_RET(eval_expression());
     }
 
-    TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACE_CLOSE));
+    TokenIndex close_token = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACE_CLOSE));
 
-    return new RangeExpression(start, end);
+    Span span = Span{this->compilation_unit->get_token(open_token)->span.start,
+                     this->compilation_unit->get_token(close_token)->span.end};
+    return new RangeExpression(start, end, span);
 }
 
 /*
@@ -600,12 +725,41 @@ TypeExpression *Parser::eval_type_primary() {
     Token *token    = peek();
 
     auto identifier = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_IDENTIFIER));
+
+    // Pool[T] and HashMap[K, V], the builtin types that take other types
+    std::string name = this->compilation_unit->get_token_string_from_index(identifier);
+    if (name == "Pool" && match(TokenType::TOKEN_BRACKET_OPEN)) {
+        consume_token_with_index();
+        TypeExpression *base_type = TRY_CALL_RET(eval_type_expression());
+        TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACKET_CLOSE));
+        return new PoolTypeExpression(base_type, token->span);
+    }
+
+    if (name == "HashMap" && match(TokenType::TOKEN_BRACKET_OPEN)) {
+        consume_token_with_index();
+        TypeExpression *key_type = TRY_CALL_RET(eval_type_expression());
+        TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_COMMA));
+        TypeExpression *value_type = TRY_CALL_RET(eval_type_expression());
+        TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACKET_CLOSE));
+        return new HashMapTypeExpression(key_type, value_type, token->span);
+    }
+
     return new IdentifierTypeExpression(identifier, token->span);
 }
 
 TypeExpression *Parser::eval_type_staic_or_slice() {
     TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_BRACKET_OPEN));
 
+    // [dyn]T, dyn is not a keyword so it is only special here
+    if (peek()->token_type == TokenType::TOKEN_IDENTIFIER &&
+        this->compilation_unit->get_token_string_from_index(this->current) == "dyn" &&
+        peek(1)->token_type == TokenType::TOKEN_BRACKET_CLOSE) {
+        consume_token_with_index();
+        consume_token_with_index();
+        TypeExpression *type_expression = TRY_CALL_RET(eval_type_unary());
+        return new DynamicArrayTypeExpression(type_expression);
+    }
+
     if (!match(TokenType::TOKEN_BRACKET_CLOSE)) { // static array type
         NumberLiteralExpression *expression = (NumberLiteralExpression *)TRY_CALL_RET(eval_number_literal());
         ASSERT_MSG(expression->type == ExpressionType::NUMBER_LITERAL,
@@ -664,19 +818,20 @@ TokenIndex Parser::consume_token_with_index() {
 TokenIndex Parser::consume_token_of_type_with_index(TokenType type) {
     if (this->current >= this->compilation_unit->token_buffer.size()) {
         Token *last_token_data = this->compilation_unit->get_token(this->compilation_unit->token_buffer.size() - 1);
-        ErrorReporter::report_parser_error(this->compilation_unit->file_data->absolute_path.string(),
-                                           last_token_data->span,
-                                           std::format("Expected '{}' but got unexpected end of file",
-                                                       get_token_type_string(last_token_data->token_type)));
+        this->error_reporter->report_parser_error(
+            this->compilation_unit->file_data->absolute_path.string(), last_token_data->span,
+            std::format("Expected '{}' but got unexpected end of file",
+                        get_token_type_string(last_token_data->token_type)));
         return 0;
     }
 
     TokenIndex current_token_index = this->current++;
     Token     *token               = this->compilation_unit->get_token(current_token_index);
     if (token->token_type != type) {
-        ErrorReporter::report_parser_error(this->compilation_unit->file_data->absolute_path.string(), token->span,
-                                           std::format("Expected '{}' got '{}'", get_token_type_string(type),
-                                                       get_token_type_string(token->token_type)));
+        this->error_reporter->report_parser_error(
+            this->compilation_unit->file_data->absolute_path.string(), token->span,
+            std::format("Expected '{}' got '{}'", get_token_type_string(type),
+                        get_token_type_string(token->token_type)));
         return 0;
     }
 
@@ -747,7 +902,8 @@ std::vector<TypeExpression *> Parser::consume_comma_seperated_types(TokenType cl
 }
 
 // e.g. x: T, y: T
-CSV Parser::consume_comma_seperated_params() {
+// fn params and struct members can also be tagged, #align(64) x: T, they are put in tags
+CSV Parser::consume_comma_seperated_params(std::vector<Tags> *tags, u16 allowed_tags) {
     auto args_types = std::vector<std::tuple<TokenIndex, TypeExpression *>>();
     bool is_first   = true;
     if (!match(TokenType::TOKEN_PAREN_CLOSE) && !match(TokenType::TOKEN_BRACE_CLOSE)) {
@@ -755,6 +911,9 @@ CSV Parser::consume_comma_seperated_params() {
             if (!is_first)
                 current++; // only iterate current by one when it is not the first time
 
+            Tags param_tags = TRY_CALL_RET(consume_tags(allowed_tags));
+            tags->push_back(param_tags);
+
             auto arg = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_IDENTIFIER));
             TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_COLON));
             auto type = TRY_CALL_RET(eval_type_expression());
@@ -769,6 +928,97 @@ CSV Parser::consume_comma_seperated_params() {
     return args_types;
 }
 
+// e.g. #packed #align(64)
+// which tags mean something depends on what they are put on so any not in allowed are an error
+Tags Parser::consume_tags(u16 allowed) {
+    static const std::tuple<const char *, u16> tag_names[] = {
+        {"align",    TAG_ALIGN   },
+        {"packed",   TAG_PACKED  },
+        {"inline",   TAG_INLINE  },
+        {"noinline", TAG_NOINLINE},
+        {"hot",      TAG_HOT     },
+        {"cold",     TAG_COLD    },
+        {"flatten",  TAG_FLATTEN },
+        {"likely",   TAG_LIKELY  },
+        {"unlikely", TAG_UNLIKELY},
+        {"simd",     TAG_SIMD    },
+        {"noalias",  TAG_NOALIAS },
+    };
+
+    // these say opposite things so only one of each can be used
+    static const u16 conflicting_tags[] = {TAG_INLINE | TAG_NOINLINE, TAG_HOT | TAG_COLD, TAG_LIKELY | TAG_UNLIKELY};
+
+    Tags tags = Tags{.flags = 0, .alignment = 0};
+    while (match(TokenType::TOKEN_HASH)) {
+        consume_token_with_index();
+        TokenIndex  name_token = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_IDENTIFIER));
+        Token      *name_data  = this->compilation_unit->get_token(name_token);
+        std::string name       = this->compilation_unit->get_token_string_from_index(name_token);
+
+        u16 flag = 0;
+        for (auto &[tag_name, tag_flag] : tag_names) {
+            if (name == tag_name) {
+                flag = tag_flag;
+            }
+        }
+
+        if (flag == 0 || (allowed & flag) == 0) {
+            std::string message = flag == 0 ? std::format("unknown tag '#{}'", name)
+                                            : std::format("tag '#{}' cannot be used here", name);
+            this->error_reporter->report_parser_error(this->compilation_unit->file_data->absolute_path.string(),
+                                                      name_data->span, message);
+            return {};
+        }
+
+        if ((tags.flags & flag) != 0) {
+            this->error_reporter->report_parser_error(this->compilation_unit->file_data->absolute_path.string(),
+                                                      name_data->span, std::format("duplicate tag '#{}'", name));
+            return {};
+        }
+        tags.flags |= flag;
+
+        for (u16 conflicting : conflicting_tags) {
+            if ((tags.flags & conflicting) != conflicting) {
+                continue;
+            }
+
+            std::string opposite_name;
+            for (auto &[tag_name, tag_flag] : tag_names) {
+                if (tag_flag == (conflicting & ~flag)) {
+                    opposite_name = tag_name;
+                }
+            }
+
+            this->error_reporter->report_parser_error(
+                this->compilation_unit->file_data->absolute_path.string(), name_data->span,
+                std::format("tag '#{}' cannot be used with '#{}'", name, opposite_name));
+            return {};
+        }
+
+        if (flag != TAG_ALIGN) {
+            continue;
+        }
+
+        // #align(64)
+        TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_PAREN_OPEN));
+        TokenIndex  number_token = TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_NUMBER_LITERAL));
+        std::string number       = this->compilation_unit->get_token_string_from_index(number_token);
+        TRY_CALL_RET(consume_token_of_type_with_index(TokenType::TOKEN_PAREN_CLOSE));
+
+        auto [end, error] = std::from_chars(number.data(), number.data() + number.size(), tags.alignment);
+        if (error != std::errc() || end != number.data() + number.size() || tags.alignment == 0 ||
+            (tags.alignment & (tags.alignment - 1)) != 0) {
+            this->error_reporter->report_parser_error(
+                this->compilation_unit->file_data->absolute_path.string(),
+                this->compilation_unit->get_token(number_token)->span,
+                std::format("alignment in '#align' must be a power of two, got '{}'", number));
+            return {};
+        }
+    }
+
+    return tags;
+}
+
 std::vector<std::tuple<TokenIndex, Expression *>> Parser::consume_comma_seperated_named_arguments(TokenType closer) {
     auto named_args = std::vector<std::tuple<TokenIndex, Expression *>>();
     bool is_first   = true;
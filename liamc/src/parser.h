@@ -22,12 +22,14 @@ struct Expression;
 struct TypeExpression;
 struct IdentifierTypeExpression;
 struct TypeInfo;
+struct ErrorReporter;
 
 struct Parser {
     u64              current;
     CompilationUnit *compilation_unit;
+    ErrorReporter   *error_reporter;
 
-    Parser(CompilationUnit *compilation_unit);
+    Parser(CompilationUnit *compilation_unit, ErrorReporter *error_reporter);
 
     void parse();
 
@@ -36,8 +38,8 @@ struct Parser {
     Statement           *eval_top_level_statement();
     LetStatement        *eval_let_statement();
     ScopeStatement      *eval_scope_statement();
-    StructStatement     *eval_struct_statement();
-    FnStatement         *eval_fn_statement();
+    StructStatement     *eval_struct_statement(Tags tags = Tags{});
+    FnStatement         *eval_fn_statement(Tags tags = Tags{});
     ReturnStatement     *eval_return_statement();
     BreakStatement      *eval_break_statement();
     ForStatement        *eval_for_statement();
@@ -71,6 +73,8 @@ struct Parser {
     Expression *eval_group_expression();
     Expression *eval_static_array_literal();
     Expression *eval_range_expression();
+    Expression *eval_arena_slice_expression();
+    Expression *eval_embed_expression();
 
     // type expressions
     TypeExpression *eval_type_expression();
@@ -89,8 +93,9 @@ struct Parser {
     std::vector<TypeExpression *>                     consume_comma_seperated_types(TokenType closer);
     std::vector<TokenIndex>                           consume_comma_seperated_token_arguments(TokenType closer);
     std::vector<std::tuple<TokenIndex, Expression *>> consume_comma_seperated_named_arguments(TokenType closer);
-    u8                                                consume_tags();
+    Tags                                              consume_tags(u16 allowed);
 
     // this is what CSV is
-    std::vector<std::tuple<TokenIndex, TypeExpression *>> consume_comma_seperated_params();
+    std::vector<std::tuple<TokenIndex, TypeExpression *>> consume_comma_seperated_params(std::vector<Tags> *tags,
+                                                                                         u16 allowed_tags);
 };
@@ -1,11 +1,12 @@
 #include "token.h"
 
-const char *TokenTypeStrings[49] = {
+const char *TokenTypeStrings[52] = {
     "int literal", "str literal", "identifier", "let",   "fn",    "(",      ")",     "{",      "}",      "+",
     "-",           "*",           "/",          "%",     "=",     ";",      ",",     ":",      "return", "^",
     "struct",      ".",           "new",        "break", "[",     "]",      "for",   "false",  "true",   "if",
     "else",        "or",          "and",        "==",    "!=",    "!",      "<",     ">",      ">=",     "<=",
-    "null",        "continue",    "zero",       "&",     "match", "import", "print", "assert", "while"};
+    "null",        "continue",    "zero",       "&",     "match", "import", "print", "assert", "while",  "arena_slice",
+    "embed",       "#"};
 
 Token::Token(TokenType token_type, u64 start, u64 end) {
     this->token_type = token_type;
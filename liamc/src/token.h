@@ -55,6 +55,9 @@ enum class TokenType {
     TOKEN_PRINT,              // print
     TOKEN_ASSERT,             // assert
     TOKEN_WHILE,              // while
+    TOKEN_ARENA_SLICE,        // arena_slice
+    TOKEN_EMBED,              // embed
+    TOKEN_HASH,               // #
 };
 
 struct Span {
@@ -0,0 +1,144 @@
+#include "trace.h"
+
+#include "ast.h"
+#include "compilation_unit.h"
+
+#include <format>
+#include <fstream>
+
+std::string escape_json_string(const std::string &string) {
+    std::string escaped;
+    escaped.reserve(string.size());
+
+    for (char c : string) {
+        switch (c) {
+        case '"':
+            escaped.append("\\\"");
+            break;
+        case '\\':
+            escaped.append("\\\\");
+            break;
+        case '\n':
+            escaped.append("\\n");
+            break;
+        case '\t':
+            escaped.append("\\t");
+            break;
+        default:
+            escaped.push_back(c);
+        }
+    }
+
+    return escaped;
+}
+
+Tracer::Tracer() {
+    this->enabled    = false;
+    this->start_time = std::chrono::high_resolution_clock::now();
+    this->events     = std::vector<TraceEvent>();
+}
+
+void Tracer::begin(std::string name, std::string category) {
+    if (!this->enabled) {
+        return;
+    }
+
+    this->events.push_back(TraceEvent{
+        .name = std::move(name), .category = std::move(category), .phase = 'B', .timestamp = now(), .value = 0});
+}
+
+void Tracer::end(std::string name, std::string category) {
+    if (!this->enabled) {
+        return;
+    }
+
+    this->events.push_back(TraceEvent{
+        .name = std::move(name), .category = std::move(category), .phase = 'E', .timestamp = now(), .value = 0});
+}
+
+void Tracer::counter(std::string name, u64 value) {
+    if (!this->enabled) {
+        return;
+    }
+
+    this->events.push_back(
+        TraceEvent{.name = std::move(name), .category = "counter", .phase = 'C', .timestamp = now(), .value = value});
+}
+
+u64 Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() -
+                                                                 this->start_time)
+        .count();
+}
+
+std::string Tracer::to_json() {
+    std::string json = "{\"traceEvents\":[\n";
+
+    for (u64 i = 0; i < this->events.size(); i++) {
+        TraceEvent *event = &this->events[i];
+        std::string name  = escape_json_string(event->name);
+
+        json.append(std::format("{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"{}\",\"ts\":{},\"pid\":1,\"tid\":1", name,
+                                escape_json_string(event->category), event->phase, event->timestamp));
+
+        // counters show up as a graph with one series per arg
+        if (event->phase == 'C') {
+            json.append(std::format(",\"args\":{{\"{}\":{}}}", name, event->value));
+        }
+
+        json.append("}");
+        if (i + 1 < this->events.size()) {
+            json.append(",");
+        }
+        json.append("\n");
+    }
+
+    json.append("],\"displayTimeUnit\":\"ms\"}\n");
+    return json;
+}
+
+bool Tracer::write_to_file(std::string path) {
+    std::ofstream file = std::ofstream(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << to_json();
+    file.close();
+    return true;
+}
+
+TraceSpan::TraceSpan(Tracer *tracer, std::string name, std::string category) {
+    // a disabled tracer is treated the same as not having one at all
+    this->tracer = NULL;
+    if (tracer == NULL || !tracer->enabled) {
+        return;
+    }
+
+    this->tracer   = tracer;
+    this->name     = std::move(name);
+    this->category = std::move(category);
+    this->tracer->begin(this->name, this->category);
+}
+
+TraceSpan::~TraceSpan() {
+    if (this->tracer != NULL) {
+        this->tracer->end(this->name, this->category);
+    }
+}
+
+std::string trace_name(Tracer *tracer, CompilationUnit *compilation_unit) {
+    if (tracer == NULL) {
+        return "";
+    }
+
+    return compilation_unit->file_data->absolute_path.filename().string();
+}
+
+std::string trace_name(Tracer *tracer, CompilationUnit *compilation_unit, FnStatement *statement) {
+    if (tracer == NULL) {
+        return "";
+    }
+
+    return compilation_unit->get_token_string_from_index(statement->identifier);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "baseLayer/types.h"
+#include "liam.h"
+
+struct CompilationUnit;
+struct FnStatement;
+
+// Records what the compiler is doing in the chrome trace event format so it can
+// be opened in chrome://tracing or https://ui.perfetto.dev, spans are nested by
+// the order they are started and ended in. When the tracer is not enabled every
+// call does nothing so it can be left in the hot paths of the compiler
+struct TraceEvent {
+    std::string name;
+    std::string category;
+    char        phase;     // 'B' begin, 'E' end, 'C' counter
+    u64         timestamp; // microseconds since the tracer was made
+    u64         value;     // only used by counters
+};
+
+struct Tracer {
+    bool                                                        enabled;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start_time;
+    std::vector<TraceEvent>                                     events;
+
+    Tracer();
+
+    void begin(std::string name, std::string category);
+    void end(std::string name, std::string category);
+    void counter(std::string name, u64 value);
+
+    u64         now();
+    std::string to_json();
+    bool        write_to_file(std::string path);
+};
+
+// begins a span when made and ends it when it goes out of scope, this means
+// early returns when errors are found still leave the trace balanced
+struct TraceSpan {
+    Tracer     *tracer;
+    std::string name;
+    std::string category;
+
+    TraceSpan(Tracer *tracer, std::string name, std::string category);
+    ~TraceSpan();
+};
+
+// names for spans, these return an empty string when there is no tracer so
+// nothing is built for each fn when tracing is turned off
+std::string trace_name(Tracer *tracer, CompilationUnit *compilation_unit);
+std::string trace_name(Tracer *tracer, CompilationUnit *compilation_unit, FnStatement *statement);
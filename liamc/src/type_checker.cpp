@@ -1,6 +1,9 @@
 #include "type_checker.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <cmath>
+#include <filesystem>
 #include <format>
 #include <iostream>
 #include <sstream>
@@ -11,15 +14,34 @@
 
 #include "ast.h"
 #include "baseLayer/debug.h"
+#include "bounds_analysis.h"
 #include "compilation_unit.h"
 #include "errors.h"
+#include "mutation_analysis.h"
+#include "parser.h"
+#include "trace.h"
 #include "liam.h"
 #include "utils.h"
 
-TypeChecker::TypeChecker() {
-    this->compilation_unit   = NULL;
-    this->compilation_bundle = NULL;
-    this->scopes             = std::list<Scope>();
+TypeChecker::TypeChecker(ErrorReporter *error_reporter) {
+    this->compilation_unit           = NULL;
+    this->compilation_bundle         = NULL;
+    this->error_reporter             = error_reporter;
+    this->tracer                     = NULL;
+    this->scopes                     = std::list<Scope>();
+    this->parallel_scope_depth       = 0;
+    this->parallel_loop_depth        = 0;
+    this->noalias_slice_params       = std::vector<std::string>();
+    this->read_only_slice_expression = NULL;
+    this->current_fn                 = NULL;
+    this->read_only_slices = std::vector<std::tuple<CompilationUnit *, Expression *, FnStatement *, std::string>>();
+    this->hash_map_type_expressions  = std::vector<std::tuple<CompilationUnit *, HashMapTypeExpression *>>();
+    this->element_type_expressions   = std::vector<std::tuple<CompilationUnit *, TypeExpression *>>();
+    this->generic_bindings           = std::vector<std::tuple<std::string, TypeInfo *>>();
+    this->generic_depth              = 0;
+    this->type_ids                   = std::unordered_map<std::string, u64>();
+    this->generic_instances          = std::map<std::tuple<FnStatement *, std::vector<u64>>, FnStatement *>();
+    this->generic_instances_to_check = std::vector<FnStatement *>();
 }
 
 void TypeChecker::new_scope() {
@@ -34,7 +56,7 @@ void TypeChecker::delete_scope() {
 void TypeChecker::add_to_scope(TokenIndex token_index, TypeInfo *type_info) {
     ASSERT_MSG(this->scopes.size() > 0, "Must be an active scope to add to");
     std::string identifier           = this->compilation_unit->get_token_string_from_index(token_index);
-    this->scopes.front()[identifier] = type_info;
+    this->scopes.back()[identifier] = type_info;
 }
 
 TypeInfo *TypeChecker::get_from_scope(TokenIndex token_index) {
@@ -57,6 +79,210 @@ TypeInfo *TypeChecker::get_from_scope(TokenIndex token_index) {
     return this->compilation_unit->get_namespace_from_scope(token_index);
 }
 
+u64 TypeChecker::get_scope_depth(TokenIndex token_index) {
+    // 1 is the outer most scope of the fn, 0 if it is not in any local scope
+    std::string identifier = this->compilation_unit->get_token_string_from_index(token_index);
+    u64         depth      = this->scopes.size();
+    for (auto iter = this->scopes.rbegin(); iter != this->scopes.rend(); iter++) {
+        if (iter->count(identifier) > 0) {
+            return depth;
+        }
+        depth--;
+    }
+
+    return 0;
+}
+
+bool TypeChecker::is_shared_in_parallel_for(Expression *expression) {
+    // follows an lvalue back to the identifier it is part of, elements of arrays
+    // and slices are not shared as each iteration is meant to use its own ones
+    // a.b --> a, *p --> p, a[i].b --> not shared
+    while (expression != NULL) {
+        switch (expression->type) {
+        case ExpressionType::IDENTIFIER: {
+            u64 depth = get_scope_depth(static_cast<IdentifierExpression *>(expression)->identifier);
+            return depth > 0 && depth < this->parallel_scope_depth;
+        }
+        case ExpressionType::GET:
+            expression = static_cast<GetExpression *>(expression)->lhs;
+            break;
+        case ExpressionType::GROUP:
+            expression = static_cast<GroupExpression *>(expression)->sub_expression;
+            break;
+        case ExpressionType::UNARY: {
+            auto unary_expression = static_cast<UnaryExpression *>(expression);
+            if (unary_expression->unary_type != UnaryType::POINTER_DEREFERENCE) {
+                return false;
+            }
+            expression = unary_expression->expression;
+        } break;
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
+
+bool TypeChecker::is_noalias_slice_param(Expression *expression) {
+    // (values) --> values, only the param itself and not a let shadowing it
+    while (expression->type == ExpressionType::GROUP) {
+        expression = static_cast<GroupExpression *>(expression)->sub_expression;
+    }
+
+    if (expression->type != ExpressionType::IDENTIFIER) {
+        return false;
+    }
+
+    TokenIndex  token_index = static_cast<IdentifierExpression *>(expression)->identifier;
+    std::string identifier  = this->compilation_unit->get_token_string_from_index(token_index);
+    for (auto &param : this->noalias_slice_params) {
+        if (param == identifier) {
+            return get_scope_depth(token_index) == 1;
+        }
+    }
+
+    return false;
+}
+
+// arenas and pools free their memory when they go out of scope so a copy would free it twice,
+// anything holding one by value cannot be copied either
+static bool can_copy(TypeInfo *type_info) {
+    switch (type_info->type) {
+    case TypeInfoType::ARENA:
+    case TypeInfoType::POOL:
+        return false;
+    case TypeInfoType::STATIC_ARRAY:
+        return can_copy(((StaticArrayTypeInfo *)type_info)->base_type);
+    case TypeInfoType::STRUCT: {
+        for (auto &[_, member_type_info] : ((StructTypeInfo *)type_info)->members) {
+            if (!can_copy(member_type_info)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+    default:
+        return true;
+    }
+}
+
+void TypeChecker::type_check_copy(Expression *expression) {
+    // rvalues like zero and new T{...} are made in place so only lvalues are copied
+    if (expression->category == ExpressionCategory::LVALUE && !can_copy(expression->type_info)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("arenas and pools cannot be copied, use a pointer to one instead")
+            .set_expr_1(expression)
+            .report(this->error_reporter);
+    }
+}
+
+// if an lvalue is part of an embedded file, embed "a.bin"[0] --> true
+static bool is_embedded(Expression *expression) {
+    while (expression != NULL) {
+        switch (expression->type) {
+        case ExpressionType::EMBED:
+            return true;
+        case ExpressionType::GET:
+            expression = static_cast<GetExpression *>(expression)->lhs;
+            break;
+        case ExpressionType::SUBSCRIPT:
+            expression = static_cast<SubscriptExpression *>(expression)->subscriptee;
+            break;
+        case ExpressionType::GROUP:
+            expression = static_cast<GroupExpression *>(expression)->sub_expression;
+            break;
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
+
+// #packed on the struct or on the member itself
+static bool is_packed_member(StructStatement *statement, u64 index) {
+    return (statement->tags.flags & TAG_PACKED) != 0 || (statement->member_tags[index].flags & TAG_PACKED) != 0;
+}
+
+// c++ only packs plain data, a member with a constructor keeps its alignment in a packed struct
+// and calling methods on one that is packed would use a misaligned this
+static bool is_plain_data(TypeInfo *type_info) {
+    switch (type_info->type) {
+    case TypeInfoType::NUMBER:
+    case TypeInfoType::BOOLEAN:
+    case TypeInfoType::POINTER:
+        return true;
+    case TypeInfoType::STATIC_ARRAY:
+        return is_plain_data(((StaticArrayTypeInfo *)type_info)->base_type);
+    case TypeInfoType::STRUCT: {
+        for (auto &[_, member_type_info] : ((StructTypeInfo *)type_info)->members) {
+            if (!is_plain_data(member_type_info)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+// if an lvalue is part of a #packed member that might not be at its alignment, p.b[0] --> true
+// when b is packed. Pointers to it would be misaligned which is undefined on some targets
+static bool is_in_packed_member(CompilationUnit *compilation_unit, Expression *expression) {
+    while (expression != NULL) {
+        switch (expression->type) {
+        case ExpressionType::GET: {
+            auto      get_expression = static_cast<GetExpression *>(expression);
+            TypeInfo *lhs_type_info  = get_expression->lhs->type_info;
+            if (lhs_type_info->type == TypeInfoType::POINTER) {
+                lhs_type_info = ((PointerTypeInfo *)lhs_type_info)->to;
+            }
+
+            StructStatement *statement = NULL;
+            if (lhs_type_info->type == TypeInfoType::STRUCT) {
+                statement = ((StructTypeInfo *)lhs_type_info)->defined_location;
+            }
+
+            std::string member = compilation_unit->get_token_string_from_index(get_expression->member);
+            for (u64 i = 0; statement != NULL && i < statement->members.size(); i++) {
+                auto &[identifier, type_expression] = statement->members[i];
+                if (statement->compilation_unit->get_token_string_from_index(identifier) == member &&
+                    is_packed_member(statement, i) && type_alignment(type_expression->type_info) > 1) {
+                    return true;
+                }
+            }
+
+            expression = get_expression->lhs;
+        } break;
+        case ExpressionType::SUBSCRIPT:
+            expression = static_cast<SubscriptExpression *>(expression)->subscriptee;
+            break;
+        case ExpressionType::GROUP:
+            expression = static_cast<GroupExpression *>(expression)->sub_expression;
+            break;
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
+
+// embed "a.bin"[{0:4}] --> true
+static bool is_embedded_slice(Expression *expression) {
+    if (expression->type != ExpressionType::SUBSCRIPT) {
+        return false;
+    }
+
+    auto subscript_expression = static_cast<SubscriptExpression *>(expression);
+    return subscript_expression->subscripter->type_info->type == TypeInfoType::RANGE &&
+           is_embedded(subscript_expression->subscriptee);
+}
+
 void TypeChecker::type_check(CompilationBundle *bundle) {
     this->compilation_bundle = bundle;
     for (CompilationUnit *cu : bundle->compilation_units) {
@@ -93,9 +319,12 @@ void TypeChecker::type_check(CompilationBundle *bundle) {
             TRY_CALL_VOID(type_check_struct_statement_full(stmt));
         }
 
+        // generic fns are only checked as the instances made from them
         for (auto stmt : this->compilation_unit->top_level_fn_statements) {
             ASSERT(stmt->statement_type != StatementType::UNDEFINED);
-            TRY_CALL_VOID(type_check_fn_decl(stmt));
+            if (stmt->generic_params.empty()) {
+                TRY_CALL_VOID(type_check_fn_decl(stmt));
+            }
         }
     }
 
@@ -108,33 +337,60 @@ void TypeChecker::type_check(CompilationBundle *bundle) {
         }
     }
 
-    this->compilation_bundle->sorted_types = TRY_CALL_VOID(topilogical_sort(all_struct_statements));
+    this->compilation_bundle->sorted_types =
+        TRY_CALL_VOID(topilogical_sort(this->error_reporter, all_struct_statements));
+
+    // sorted types come after every struct they hold so they can be laid out in order
+    for (SortingNode &node : this->compilation_bundle->sorted_types) {
+        u64 natural_alignment = compute_struct_layout(node.type_info);
+        TRY_CALL_VOID(type_check_struct_tags(node.type_info, natural_alignment));
+    }
 
     for (CompilationUnit *cu : bundle->compilation_units) {
         this->compilation_unit = cu;
+        TraceSpan cu_span      = TraceSpan(this->tracer, trace_name(this->tracer, cu), "type check");
 
         // finally do the function body pass
         for (auto stmt : this->compilation_unit->top_level_fn_statements) {
+            if (!stmt->generic_params.empty()) {
+                continue;
+            }
+
+            TraceSpan fn_span = TraceSpan(this->tracer, trace_name(this->tracer, cu, stmt), "type check");
             TRY_CALL_VOID(type_check_fn_statement_full(stmt));
         }
     }
 
+    TRY_CALL_VOID(type_check_generic_instances());
+    TRY_CALL_VOID(type_check_hash_map_keys());
+    TRY_CALL_VOID(type_check_element_types());
+    TRY_CALL_VOID(type_check_read_only_slices());
     TRY_CALL_VOID(find_entry_point());
 }
 
 void TypeChecker::find_entry_point() {
     for (CompilationUnit *cu : this->compilation_bundle->compilation_units) {
         for (auto stmt : cu->top_level_fn_statements) {
-            if (cu->get_token_string_from_index(stmt->identifier) == "main") {
-                this->compilation_bundle->entry_point = stmt;
+            if (cu->get_token_string_from_index(stmt->identifier) != "main") {
+                continue;
+            }
+
+            // there would be nothing to make the instance from
+            if (!stmt->generic_params.empty()) {
+                TypeCheckerError::make(cu->file_data->absolute_path.string())
+                    .set_message("'main' function cannot be generic")
+                    .report(this->error_reporter);
                 return;
             }
+
+            this->compilation_bundle->entry_point = stmt;
+            return;
         }
     }
 
     TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
         .set_message("no enrty point found, 'main' function must be defined")
-        .report();
+        .report(this->error_reporter);
 }
 
 void TypeChecker::type_check_import_statement(ImportStatement *statement) {
@@ -151,7 +407,7 @@ void TypeChecker::type_check_import_statement(ImportStatement *statement) {
     if (!compilation_unit_index.is_some()) {
         TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
             .set_message(std::format("cannot find file with import path '{}' ", import_path))
-            .report();
+            .report(this->error_reporter);
 
         return;
     }
@@ -164,7 +420,7 @@ void TypeChecker::type_check_import_statement(ImportStatement *statement) {
         std::string identifier = this->compilation_unit->get_token_string_from_index(statement->identifier);
         TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
             .set_message(std::format("duplicate creation of namespace identifier '{}' ", identifier))
-            .report();
+            .report(this->error_reporter);
 
         return;
     }
@@ -173,12 +429,17 @@ void TypeChecker::type_check_import_statement(ImportStatement *statement) {
 }
 
 void TypeChecker::type_check_fn_symbol(FnStatement *statement) {
-    ScopeActionStatus status = this->compilation_unit->add_fn_to_scope(statement->identifier, new FnTypeInfo(NULL, {}));
+    statement->type_info = new FnTypeInfo(NULL, {});
+    if (!statement->generic_params.empty()) {
+        statement->type_info->generic_statement = statement;
+    }
+
+    ScopeActionStatus status = this->compilation_unit->add_fn_to_scope(statement->identifier, statement->type_info);
     if (status == ScopeActionStatus::ALREADY_EXISTS) {
         std::string identifier = this->compilation_unit->get_token_string_from_index(statement->identifier);
         TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
             .set_message(std::format("duplicate creation of fn '{}' ", identifier))
-            .report();
+            .report(this->error_reporter);
 
         return;
     }
@@ -195,7 +456,7 @@ void TypeChecker::type_check_struct_symbol(StructStatement *statement) {
         std::string identifier = this->compilation_unit->get_token_string_from_index(statement->identifier);
         TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
             .set_message(std::format("duplicate creation of type '{}' ", identifier))
-            .report();
+            .report(this->error_reporter);
 
         return;
     }
@@ -203,29 +464,53 @@ void TypeChecker::type_check_struct_symbol(StructStatement *statement) {
 
 void TypeChecker::type_check_fn_decl(FnStatement *statement) {
     auto param_type_infos = std::vector<TypeInfo *>();
-    for (auto &[identifier, expr] : statement->params) {
+    for (u64 i = 0; i < statement->params.size(); i++) {
+        auto &[identifier, expr] = statement->params[i];
         TRY_CALL_VOID(type_check_type_expression(expr))
+
+        // only the data a slice or pointer points to can be said to not overlap with anything else
+        if ((statement->param_tags[i].flags & TAG_NOALIAS) != 0 && expr->type_info->type != TypeInfoType::SLICE &&
+            expr->type_info->type != TypeInfoType::POINTER) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("only slice and pointer params can be tagged with #noalias")
+                .set_type_expr_1(expr)
+                .report(this->error_reporter);
+            return;
+        }
+
+        // a copy would free the same memory as the original when it goes out of scope
+        if (!can_copy(expr->type_info)) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("arenas and pools cannot be copied, pass a pointer to one instead")
+                .set_type_expr_1(expr)
+                .report(this->error_reporter);
+            return;
+        }
+
         param_type_infos.push_back(expr->type_info);
     }
 
     TRY_CALL_VOID(type_check_type_expression(statement->return_type));
+    if (!can_copy(statement->return_type->type_info)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("arenas and pools cannot be copied, return a pointer to one instead")
+            .set_type_expr_1(statement->return_type)
+            .report(this->error_reporter);
+        return;
+    }
 
-    std::string name_as_string = this->compilation_unit->get_token_string_from_index(statement->identifier);
-
-    // the current scope is always the fn scope
-    auto current_type_info     = (FnTypeInfo *)this->compilation_unit->get_fn_from_scope(statement->identifier);
+    // the type info is made when the symbol is added or the instance is made
+    FnTypeInfo *current_type_info = statement->type_info;
     ASSERT(current_type_info);
     current_type_info->return_type = statement->return_type->type_info;
     current_type_info->args        = param_type_infos;
 }
 
 void TypeChecker::type_check_fn_statement_full(FnStatement *statement) {
-    // getting the already existing type info for the function is done in 2 ways
-    // 1. looking into the symbol table of the current scope (normal function)
-    // 2. looking into the member functions of a type (member function)
-    FnTypeInfo *fn_type_info = NULL;
+    this->current_fn = statement;
 
-    fn_type_info             = (FnTypeInfo *)this->compilation_unit->get_fn_from_scope(statement->identifier);
+    // the type info was filled in by type_check_fn_decl
+    FnTypeInfo *fn_type_info = statement->type_info;
     ASSERT(fn_type_info);
 
     // params and get type expressions
@@ -237,12 +522,50 @@ void TypeChecker::type_check_fn_statement_full(FnStatement *statement) {
         args[i]                  = {identifier, fn_type_info->args.at(i)};
     }
 
+    this->noalias_slice_params.clear();
+    for (u64 i = 0; i < args.size(); i++) {
+        auto &[identifier, type_info] = args[i];
+        if ((statement->param_tags[i].flags & TAG_NOALIAS) != 0 && type_info->type == TypeInfoType::SLICE) {
+            this->noalias_slice_params.push_back(this->compilation_unit->get_token_string_from_index(identifier));
+        }
+    }
+
     this->new_scope();
     for (auto &[token_index, type_info] : args) {
         this->add_to_scope(token_index, type_info);
     }
     TRY_CALL_VOID(type_check_scope_statement(statement->body));
     this->delete_scope();
+    this->noalias_slice_params.clear();
+
+    // any param holding a pointer could point at the caller's value a reference would share
+    u64 params_holding_pointers = 0;
+    for (auto &[_, type_info] : args) {
+        params_holding_pointers += holds_pointer(type_info) ? 1 : 0;
+    }
+
+    // big structs, dynamic arrays and hash maps that the body never changes are passed as a const
+    // reference, this is the same to the caller as passing a copy but without copying it every call.
+    // Only when no other param can be used to change the value the reference is to
+    for (u64 i = 0; i < args.size(); i++) {
+        auto &[identifier, type_info] = args[i];
+        if (type_info->type != TypeInfoType::DYNAMIC_ARRAY && type_info->type != TypeInfoType::HASH_MAP &&
+            (type_info->type != TypeInfoType::STRUCT || type_size(type_info) <= PASS_BY_REFERENCE_THRESHOLD)) {
+            continue;
+        }
+
+        if (params_holding_pointers > (holds_pointer(type_info) ? 1 : 0)) {
+            continue;
+        }
+
+        MutationAnalysis mutation_analysis =
+            MutationAnalysis(this->compilation_unit, {this->compilation_unit->get_token_string_from_index(identifier)});
+        statement->params_by_reference[i] = !mutation_analysis.might_mutate_statement(statement->body);
+    }
+
+    // subscripts that can never be out of bounds are not checked in debug builds
+    BoundsAnalysis bounds_analysis = BoundsAnalysis(this->compilation_unit);
+    bounds_analysis.analyse_statement(statement->body);
 
     // TODO: we should type checking the returns from return statement up
     // when they are typed we should go back up the tree and check their types
@@ -256,13 +579,13 @@ void TypeChecker::type_check_fn_statement_full(FnStatement *statement) {
                     TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
                         .set_expr_1(return_statement->expression)
                         .set_message("found expression in return when return type is void")
-                        .report();
+                        .report(this->error_reporter);
 
                     return;
                 }
             } else {
                 if (!type_match(fn_type_info->return_type, return_statement->expression->type_info)) {
-                    ErrorReporter::report_type_checker_error(
+                    this->error_reporter->report_type_checker_error(
                         compilation_unit->file_data->absolute_path.string(), return_statement->expression, NULL,
                         statement->return_type, NULL, "mismatch types in function, return types do not match");
                     return;
@@ -272,6 +595,43 @@ void TypeChecker::type_check_fn_statement_full(FnStatement *statement) {
     }
 }
 
+void TypeChecker::type_check_struct_tags(StructTypeInfo *struct_type_info, u64 natural_alignment) {
+    // alignas can only raise the alignment, anything lower is an error in clang and ignored by gcc
+    StructStatement *statement = struct_type_info->defined_location;
+    std::string      path      = statement->compilation_unit->file_data->absolute_path.string();
+    for (u64 i = 0; i < statement->members.size(); i++) {
+        auto &[_, type_expression] = statement->members[i];
+        if (is_packed_member(statement, i) && !is_plain_data(type_expression->type_info)) {
+            TypeCheckerError::make(path)
+                .set_message("#packed members can only be numbers, bools, pointers and arrays and structs of them, "
+                             "c++ does not pack anything else")
+                .set_type_expr_1(type_expression)
+                .report(this->error_reporter);
+            return;
+        }
+
+        u64 alignment = statement->member_tags[i].alignment;
+        if (alignment != 0 && alignment < type_alignment(type_expression->type_info)) {
+            TypeCheckerError::make(path)
+                .set_message(std::format("#align({}) is less than the {} byte alignment of the member, #align can "
+                                         "only raise it",
+                                         alignment, type_alignment(type_expression->type_info)))
+                .set_type_expr_1(type_expression)
+                .report(this->error_reporter);
+            return;
+        }
+    }
+
+    if (statement->tags.alignment != 0 && statement->tags.alignment < natural_alignment) {
+        std::string identifier = statement->compilation_unit->get_token_string_from_index(statement->identifier);
+        TypeCheckerError::make(path)
+            .set_message(std::format("#align({}) on '{}' is less than its {} byte alignment, #align can only raise it",
+                                     statement->tags.alignment, identifier, natural_alignment))
+            .report(this->error_reporter);
+        return;
+    }
+}
+
 void TypeChecker::type_check_struct_statement_full(StructStatement *statement) {
     auto members_type_info = std::vector<std::tuple<std::string, TypeInfo *>>();
     members_type_info.reserve(statement->members.size());
@@ -328,29 +688,63 @@ void TypeChecker::type_check_statement(Statement *statement) {
 }
 
 void TypeChecker::type_check_return_statement(ReturnStatement *statement) {
-    if (statement->expression)
+    if (this->parallel_scope_depth > 0) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot return from inside a for par, the other threads would still be running")
+            .set_expr_1(statement->expression)
+            .report(this->error_reporter);
+        return;
+    }
+
+    if (statement->expression) {
         TRY_CALL_VOID(type_check_expression(statement->expression));
+        TRY_CALL_VOID(type_check_copy(statement->expression));
+    }
 }
 
 void TypeChecker::type_check_break_statement(BreakStatement *statement) {
+    // breaking out of a loop inside the for par is fine
+    if (this->parallel_scope_depth > 0 && this->parallel_loop_depth == 0) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot break out of a for par, the other threads would still be running")
+            .report(this->error_reporter);
+    }
 }
 
 void TypeChecker::type_check_let_statement(LetStatement *statement) {
+    this->read_only_slice_expression = statement->rhs;
     TRY_CALL_VOID(type_check_expression(statement->rhs));
+    TRY_CALL_VOID(type_check_copy(statement->rhs));
+
+    if (is_embedded_slice(statement->rhs)) {
+        this->read_only_slices.push_back({this->compilation_unit, statement->rhs, this->current_fn,
+                                          this->compilation_unit->get_token_string_from_index(statement->identifier)});
+    }
+
+    // a copy made in the body would get around not being able to pass it to a fn
+    if (this->parallel_scope_depth > 0 && holds_pointer(statement->rhs->type_info) &&
+        is_shared_in_parallel_for(statement->rhs)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot copy a value holding a pointer from outside a for par")
+            .set_expr_1(statement->rhs)
+            .report(this->error_reporter);
+        return;
+    }
 
     // if let type is there type match both and set var type
     // to the let type... else just set it to the rhs
     if (statement->type != NULL) {
         TRY_CALL_VOID(type_check_type_expression(statement->type));
         if (!type_match(statement->type->type_info, statement->rhs->type_info)) {
-            ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
-                                                     statement->rhs, NULL, statement->type, NULL,
-                                                     "mismatched types in let statement");
+            this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                            statement->rhs, NULL, statement->type, NULL,
+                                                            "mismatched types in let statement");
             return;
         }
     } else if (statement->rhs->type_info->type == TypeInfoType::ANY) {
-        ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), statement->rhs,
-                                                 NULL, NULL, NULL, "cannot infer type of expression in let statement");
+        this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                        statement->rhs, NULL, NULL, NULL,
+                                                        "cannot infer type of expression in let statement");
         return;
     }
 
@@ -368,21 +762,44 @@ void TypeChecker::type_check_scope_statement(ScopeStatement *statement) {
 }
 
 void TypeChecker::type_check_for_statement(ForStatement *statement) {
+    this->read_only_slice_expression = statement->expression;
     TRY_CALL_VOID(type_check_expression(statement->expression));
 
+    // the loop goes through a pointer to what it is over
+    if (is_in_packed_member(this->compilation_unit, statement->expression)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot use a for over a #packed member, it might not be aligned, copy it into a let first")
+            .set_expr_1(statement->expression)
+            .report(this->error_reporter);
+        return;
+    }
+
+    if (statement->value_is_pointer && is_embedded(statement->expression)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot use for ^ over an embedded file, it is read only, copy it into a let first")
+            .set_expr_1(statement->expression)
+            .report(this->error_reporter);
+        return;
+    }
+
     TypeInfoType expression_type_info_type = statement->expression->type_info->type;
 
     if (expression_type_info_type == TypeInfoType::STATIC_ARRAY) {
         statement->for_type = ForType::STATIC_ARRAY;
     } else if (expression_type_info_type == TypeInfoType::SLICE) {
         statement->for_type = ForType::SLICE;
+    } else if (expression_type_info_type == TypeInfoType::DYNAMIC_ARRAY) {
+        statement->for_type = ForType::DYNAMIC_ARRAY;
+    } else if (expression_type_info_type == TypeInfoType::HASH_MAP) {
+        statement->for_type = ForType::HASH_MAP;
     } else if (expression_type_info_type == TypeInfoType::RANGE) {
         statement->for_type = ForType::RANGE;
     } else {
         TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
-            .set_message("incorrect type given in for statement, must use a static array, slice or range")
+            .set_message("incorrect type given in for statement, must use a static array, dynamic array, slice, "
+                         "hash map or range")
             .set_expr_1(statement->expression)
-            .report();
+            .report(this->error_reporter);
         return;
     }
 
@@ -397,13 +814,55 @@ void TypeChecker::type_check_for_statement(ForStatement *statement) {
     case ForType::SLICE: {
         value_type_info = ((SliceTypeInfo *)statement->expression->type_info)->base_type;
     } break;
+    case ForType::DYNAMIC_ARRAY: {
+        value_type_info = ((DynamicArrayTypeInfo *)statement->expression->type_info)->base_type;
+    } break;
+    case ForType::HASH_MAP: {
+        // changing a key in place would leave it in the wrong slot, values can be changed with find
+        if (statement->value_is_pointer) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("cannot get a pointer to the entries of a hash map in for loops, use find to change a "
+                             "value")
+                .set_expr_1(statement->expression)
+                .report(this->error_reporter);
+            return;
+        }
+
+        // the entries are not in any order so there is nothing to split between threads
+        if (statement->is_parallel) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("cannot use a hash map in a for par")
+                .set_expr_1(statement->expression)
+                .report(this->error_reporter);
+            return;
+        }
+
+        // there is no indexed loop for the compiler to vectorize
+        if ((statement->tags.flags & TAG_SIMD) != 0) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("cannot use #simd on a for over a hash map")
+                .set_expr_1(statement->expression)
+                .report(this->error_reporter);
+            return;
+        }
+
+        value_type_info = ((HashMapTypeInfo *)statement->expression->type_info)->entry_type;
+    } break;
     case ForType::RANGE: {
         RangeExpression *range_expression = (RangeExpression *)statement->expression;
         if (range_expression->start == NULL || range_expression->end == NULL) {
             TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
                 .set_message("range expression must have both a start and end value in for loops")
                 .set_expr_1(statement->expression)
-                .report();
+                .report(this->error_reporter);
+            return;
+        }
+
+        if (statement->value_is_pointer) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("cannot get a pointer to the values of a range in for loops")
+                .set_expr_1(statement->expression)
+                .report(this->error_reporter);
             return;
         }
 
@@ -413,19 +872,69 @@ void TypeChecker::type_check_for_statement(ForStatement *statement) {
         UNREACHABLE();
     }
 
+    if (statement->value_is_pointer) {
+        value_type_info = new PointerTypeInfo(value_type_info);
+    } else if (!can_copy(value_type_info)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("arenas and pools cannot be copied, use for ^ to get a pointer to each one")
+            .set_expr_1(statement->expression)
+            .report(this->error_reporter);
+        return;
+    }
+
+    if (statement->grain != NULL) {
+        TRY_CALL_VOID(type_check_expression(statement->grain));
+        if (statement->grain->type_info->type != TypeInfoType::NUMBER ||
+            ((NumberTypeInfo *)statement->grain->type_info)->number_type == NumberType::FLOAT) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("grain size of a for par must be a non-float number")
+                .set_expr_1(statement->grain)
+                .report(this->error_reporter);
+            return;
+        }
+    }
+
+    // the body of a for par starts a new set of values that are not shared
+    u64 outer_parallel_scope_depth = this->parallel_scope_depth;
+    u64 outer_parallel_loop_depth  = this->parallel_loop_depth;
     this->new_scope();
+    if (statement->is_parallel) {
+        this->parallel_scope_depth = this->scopes.size();
+        this->parallel_loop_depth  = 0;
+    } else {
+        this->parallel_loop_depth++;
+    }
+
     this->add_to_scope(statement->value_identifier, value_type_info);
     TRY_CALL_VOID(type_check_scope_statement(statement->body));
     this->delete_scope();
+    this->parallel_scope_depth = outer_parallel_scope_depth;
+    this->parallel_loop_depth  = outer_parallel_loop_depth;
+
+    // the value can be a reference to the element instead of a copy if nothing in
+    // the body could change the value or what is being iterated over, done after
+    // the body is type checked as it needs to know the types of fn args
+    if (statement->for_type != ForType::RANGE && !statement->value_is_pointer) {
+        std::vector<std::string> watched = {
+            this->compilation_unit->get_token_string_from_index(statement->value_identifier)};
+
+        IdentifierExpression *iterated = root_identifier(statement->expression);
+        if (iterated != NULL) {
+            watched.push_back(this->compilation_unit->get_token_string_from_index(iterated->identifier));
+        }
+
+        MutationAnalysis mutation_analysis = MutationAnalysis(this->compilation_unit, watched);
+        statement->value_is_reference      = !mutation_analysis.might_mutate_statement(statement->body);
+    }
 }
 
 void TypeChecker::type_check_if_statement(IfStatement *statement) {
     TRY_CALL_VOID(type_check_expression(statement->expression));
 
     if (!type_match(statement->expression->type_info, this->compilation_unit->global_type_scope["bool"])) {
-        ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
-                                                 statement->expression, NULL, NULL, NULL,
-                                                 "can only pass boolean expressions to if statements");
+        this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                        statement->expression, NULL, NULL, NULL,
+                                                        "can only pass boolean expressions to if statements");
         return;
     }
 
@@ -458,14 +967,31 @@ void TypeChecker::type_check_assigment_statement(AssigmentStatement *statement)
         TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
             .set_message("trying to assign to a rvalue, only lvalues can be assigned")
             .set_expr_1(statement->lhs)
-            .report();
+            .report(this->error_reporter);
+        return;
+    }
+
+    if (this->parallel_scope_depth > 0 && is_shared_in_parallel_for(statement->lhs)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot assign to a value from outside a for par, every thread would write to it at once")
+            .set_expr_1(statement->lhs)
+            .report(this->error_reporter);
+        return;
+    }
+
+    // even a zero would be copied over the one there, which would never free its memory
+    if (!can_copy(statement->lhs->type_info)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot assign to an arena or pool or anything holding one")
+            .set_expr_1(statement->lhs)
+            .report(this->error_reporter);
         return;
     }
 
     TRY_CALL_VOID(type_check_expression(statement->assigned_to->expression));
 
     if (!type_match(statement->lhs->type_info, statement->assigned_to->expression->type_info)) {
-        ErrorReporter::report_type_checker_error(
+        this->error_reporter->report_type_checker_error(
             compilation_unit->file_data->absolute_path.string(), statement->lhs, statement->assigned_to->expression,
             NULL, NULL, "type mismatch, trying to assign a identifier to an expression of different type");
         return;
@@ -477,6 +1003,7 @@ void TypeChecker::type_check_expression_statement(ExpressionStatement *statement
 }
 
 void TypeChecker::type_check_print_statement(PrintStatement *statement) {
+    this->read_only_slice_expression = statement->expression;
     TRY_CALL_VOID(type_check_expression(statement->expression));
 }
 
@@ -486,7 +1013,7 @@ void TypeChecker::type_check_assert_statement(AssertStatement *statement) {
         TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
             .set_message("assert statement must be a boolean expression")
             .set_expr_1(statement->expression)
-            .report();
+            .report(this->error_reporter);
     }
 }
 
@@ -496,11 +1023,13 @@ void TypeChecker::type_check_while_statement(WhileStatement *statement) {
         TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
             .set_message("condition for while statement must be a boolean")
             .set_expr_1(statement->expression)
-            .report();
+            .report(this->error_reporter);
     }
 
     this->new_scope();
+    this->parallel_loop_depth++;
     TRY_CALL_VOID(type_check_scope_statement(statement->body));
+    this->parallel_loop_depth--;
     this->delete_scope();
 }
 
@@ -551,6 +1080,12 @@ void TypeChecker::type_check_expression(Expression *expression) {
     case ExpressionType::RANGE:
         return type_check_range_expression(static_cast<RangeExpression *>(expression));
         break;
+    case ExpressionType::ARENA_SLICE:
+        return type_check_arena_slice_expression(static_cast<ArenaSliceExpression *>(expression));
+        break;
+    case ExpressionType::EMBED:
+        return type_check_embed_expression(static_cast<EmbedExpression *>(expression));
+        break;
     case ExpressionType::UNDEFINED:
         UNREACHABLE();
     default:
@@ -563,8 +1098,9 @@ void TypeChecker::type_check_binary_expression(BinaryExpression *expression) {
     TRY_CALL_VOID(type_check_expression(expression->right));
 
     if (!type_match(expression->left->type_info, expression->right->type_info)) {
-        ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expression->left,
-                                                 expression->right, NULL, NULL, "type mismatch in binary expression");
+        this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                        expression->left, expression->right, NULL, NULL,
+                                                        "type mismatch in binary expression");
         return;
     }
 
@@ -574,9 +1110,9 @@ void TypeChecker::type_check_binary_expression(BinaryExpression *expression) {
     if (expression->op == TokenType::TOKEN_AND || expression->op == TokenType::TOKEN_OR) {
         if (expression->left->type_info->type != TypeInfoType::BOOLEAN &&
             expression->right->type_info->type != TypeInfoType::BOOLEAN) {
-            ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
-                                                     expression->left, expression->right, NULL, NULL,
-                                                     "cannot use logical operators on non bool type");
+            this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                            expression->left, expression->right, NULL, NULL,
+                                                            "cannot use logical operators on non bool type");
             return;
         }
 
@@ -587,10 +1123,28 @@ void TypeChecker::type_check_binary_expression(BinaryExpression *expression) {
     if (expression->op == TokenType::TOKEN_PLUS || expression->op == TokenType::TOKEN_STAR ||
         expression->op == TokenType::TOKEN_SLASH || expression->op == TokenType::TOKEN_MOD ||
         expression->op == TokenType::TOKEN_MINUS) {
-        if (expression->left->type_info->type != TypeInfoType::NUMBER) {
-            ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
-                                                     expression->left, expression->right, NULL, NULL,
-                                                     "cannot use arithmatic operator on non number");
+        // vectors are lane wise
+        if (expression->left->type_info->type != TypeInfoType::NUMBER &&
+            expression->left->type_info->type != TypeInfoType::VECTOR) {
+            this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                            expression->left, expression->right, NULL, NULL,
+                                                            "cannot use arithmatic operator on non number");
+            return;
+        }
+
+        // c++ has no % for floats, this goes for each lane of a float vector too
+        NumberTypeInfo *number_type_info = NULL;
+        if (expression->left->type_info->type == TypeInfoType::VECTOR) {
+            number_type_info = ((VectorTypeInfo *)expression->left->type_info)->base_type;
+        } else {
+            number_type_info = (NumberTypeInfo *)expression->left->type_info;
+        }
+
+        if (expression->op == TokenType::TOKEN_MOD && number_type_info->number_type == NumberType::FLOAT) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("cannot use % on floats")
+                .set_expr_1(expression)
+                .report(this->error_reporter);
             return;
         }
         info = expression->left->type_info;
@@ -599,10 +1153,11 @@ void TypeChecker::type_check_binary_expression(BinaryExpression *expression) {
     // math ops - numbers -> bool
     if (expression->op == TokenType::TOKEN_LESS || expression->op == TokenType::TOKEN_GREATER ||
         expression->op == TokenType::TOKEN_GREATER_EQUAL || expression->op == TokenType::TOKEN_LESS_EQUAL) {
-        if (expression->left->type_info->type != TypeInfoType::NUMBER) {
-            ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
-                                                     expression->left, expression->right, NULL, NULL,
-                                                     "cannot use comparison operator on non number");
+        if (expression->left->type_info->type != TypeInfoType::NUMBER &&
+            expression->left->type_info->type != TypeInfoType::VECTOR) {
+            this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                            expression->left, expression->right, NULL, NULL,
+                                                            "cannot use comparison operator on non number");
             return;
         }
         info = this->compilation_unit->global_type_scope["bool"];
@@ -613,6 +1168,12 @@ void TypeChecker::type_check_binary_expression(BinaryExpression *expression) {
         info = this->compilation_unit->global_type_scope["bool"];
     }
 
+    // comparing vectors is lane wise and gives a mask - f32x4 -> i32x4
+    if (info != NULL && info->type == TypeInfoType::BOOLEAN &&
+        expression->left->type_info->type == TypeInfoType::VECTOR) {
+        info = vector_mask_type((VectorTypeInfo *)expression->left->type_info);
+    }
+
     assert(info != NULL);
 
     expression->type_info = info;
@@ -669,21 +1230,23 @@ void TypeChecker::type_check_number_literal_expression(NumberLiteralExpression *
                     number_type = NumberType::FLOAT;
                     dot_count++;
                 } else {
-                    ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
-                                                             expression, NULL, NULL, NULL,
-                                                             "trying to use '.' in non float literal");
+                    this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                                    expression, NULL, NULL, NULL,
+                                                                    "trying to use '.' in non float literal");
                     return;
                 }
             } else if (!isdigit(c)) {
-                ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
-                                                         expression, NULL, NULL, NULL, "malformed number literal");
+                this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                                expression, NULL, NULL, NULL,
+                                                                "malformed number literal");
                 return;
             }
         }
 
         if (dot_count > 1) {
-            ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expression,
-                                                     NULL, NULL, NULL, "float number literals can only have one dot");
+            this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                            expression, NULL, NULL, NULL,
+                                                            "float number literals can only have one dot");
             return;
         }
     }
@@ -706,7 +1269,23 @@ void TypeChecker::type_check_number_literal_expression(NumberLiteralExpression *
         iss >> number_value.u;
     } break;
     case NumberType::FLOAT: {
-        iss >> number_value.f;
+        // f32 is read as a float so it is only rounded once, reading it as a
+        // double and then narrowing can land on a different value
+        if (number_size == NumberSize::SIZE_32) {
+            f32 value = 0;
+            iss >> value;
+            number_value.f = value;
+        } else {
+            iss >> number_value.f;
+        }
+
+        // out of range values are clamped to the max and the stream fails
+        if (iss.fail() || std::isinf(number_value.f)) {
+            this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                            expression, NULL, NULL, NULL,
+                                                            "float number literal is too large for its type");
+            return;
+        }
     } break;
     default:
         UNREACHABLE();
@@ -730,13 +1309,47 @@ void TypeChecker::type_check_unary_expression(UnaryExpression *expression) {
     TRY_CALL_VOID(type_check_expression(expression->expression));
 
     if (expression->unary_type == UnaryType::POINTER) {
+        if (is_in_packed_member(this->compilation_unit, expression->expression)) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("cannot get a pointer to a #packed member, it might not be aligned")
+                .set_expr_1(expression)
+                .report(this->error_reporter);
+            return;
+        }
+
+        if (is_embedded(expression->expression)) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("cannot get a pointer into an embedded file, it is read only, copy it into a let first")
+                .set_expr_1(expression)
+                .report(this->error_reporter);
+            return;
+        }
+
+        if (is_noalias_slice_param(expression->expression)) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("cannot get a pointer to a #noalias slice param, copy it into a let first")
+                .set_expr_1(expression)
+                .report(this->error_reporter);
+            return;
+        }
+
+        // a pointer would let the threads write to it without being an assignment here
+        if (this->parallel_scope_depth > 0 && is_shared_in_parallel_for(expression->expression)) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("cannot get a pointer to a value from outside a for par")
+                .set_expr_1(expression)
+                .report(this->error_reporter);
+            return;
+        }
+
         expression->type_info = new PointerTypeInfo(expression->expression->type_info);
         expression->category  = ExpressionCategory::RVALUE;
         return;
     } else if (expression->unary_type == UnaryType::POINTER_DEREFERENCE) {
         if (expression->expression->type_info->type != TypeInfoType::POINTER) {
-            ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expression,
-                                                     NULL, NULL, NULL, "cannot dereference non-pointer value");
+            this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                            expression, NULL, NULL, NULL,
+                                                            "cannot dereference non-pointer value");
             return;
         }
 
@@ -745,9 +1358,9 @@ void TypeChecker::type_check_unary_expression(UnaryExpression *expression) {
         return;
     } else if (expression->unary_type == UnaryType::NOT) {
         if (expression->expression->type_info->type != TypeInfoType::BOOLEAN) {
-            ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expression,
-                                                     NULL, NULL, NULL,
-                                                     "cannot use unary operator ! on non-boolean type");
+            this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                            expression, NULL, NULL, NULL,
+                                                            "cannot use unary operator ! on non-boolean type");
             return;
         }
 
@@ -755,10 +1368,11 @@ void TypeChecker::type_check_unary_expression(UnaryExpression *expression) {
         expression->category  = ExpressionCategory::RVALUE;
         return;
     } else if (expression->unary_type == UnaryType::MINUS) {
-        if (expression->expression->type_info->type != TypeInfoType::NUMBER) {
-            ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expression,
-                                                     NULL, NULL, NULL,
-                                                     "cannot use unary operator - on non-number type");
+        if (expression->expression->type_info->type != TypeInfoType::NUMBER &&
+            expression->expression->type_info->type != TypeInfoType::VECTOR) {
+            this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                            expression, NULL, NULL, NULL,
+                                                            "cannot use unary operator - on non-number type");
             return;
         }
 
@@ -776,19 +1390,39 @@ void TypeChecker::type_check_call_expression(CallExpression *expression) {
     Expression *callee_expression = expression->callee;
 
     if (expression->callee->type_info->type != TypeInfoType::FN) {
-        ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), callee_expression,
-                                                 NULL, NULL, NULL, "can only call functions");
+        this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                        callee_expression, NULL, NULL, NULL, "can only call functions");
     }
 
+    // only fns written in liam can be checked for writing through a slice of an embedded file
+    bool is_builtin     = ((FnTypeInfo *)expression->callee->type_info)->is_builtin;
     auto arg_type_infos = std::vector<TypeInfo *>();
     for (auto arg : expression->args) {
+        this->read_only_slice_expression = is_builtin ? NULL : arg;
         TRY_CALL_VOID(type_check_expression(arg));
         arg_type_infos.push_back(arg->type_info);
+
+        // the fn could write through it from every thread at once
+        if (this->parallel_scope_depth > 0 && holds_pointer(arg->type_info) && is_shared_in_parallel_for(arg)) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("cannot pass a value holding a pointer from outside a for par to a fn")
+                .set_expr_1(arg)
+                .report(this->error_reporter);
+            return;
+        }
     }
 
+    // a generic fn is called through the instance made for the types of the args
     auto fn_type_info = static_cast<FnTypeInfo *>(callee_expression->type_info);
+    if (fn_type_info->generic_statement != NULL) {
+        FnStatement *instance =
+            TRY_CALL_VOID(instantiate_generic_fn(fn_type_info->generic_statement, expression, arg_type_infos));
+        expression->generic_instance = instance;
+        fn_type_info                 = instance->type_info;
+    }
+
     if (fn_type_info->args.size() != arg_type_infos.size()) {
-        ErrorReporter::report_type_checker_error(
+        this->error_reporter->report_type_checker_error(
             compilation_unit->file_data->absolute_path.string(), callee_expression, NULL, NULL, NULL,
             std::format("incorrect number of arguments in call expression, expected {} got {}",
                         fn_type_info->args.size(), arg_type_infos.size()));
@@ -797,22 +1431,54 @@ void TypeChecker::type_check_call_expression(CallExpression *expression) {
 
     for (u64 i = 0; i < fn_type_info->args.size(); i++) {
         if (!type_match(fn_type_info->args.at(i), arg_type_infos.at(i))) {
-            ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
-                                                     callee_expression, expression->args.at(i), NULL, NULL,
-                                                     "mismatched types function call");
+            this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(),
+                                                            callee_expression, expression->args.at(i), NULL, NULL,
+                                                            "mismatched types function call");
             return;
         }
     }
 
+    for (u64 i = 0; i < expression->args.size(); i++) {
+        if (!is_embedded_slice(expression->args[i])) {
+            continue;
+        }
+
+        FnStatement *fn_statement = expression->generic_instance;
+        for (u64 j = 0; fn_statement == NULL && j < this->compilation_bundle->compilation_units.size(); j++) {
+            for (auto stmt : this->compilation_bundle->compilation_units[j]->top_level_fn_statements) {
+                if (stmt->type_info == fn_type_info) {
+                    fn_statement = stmt;
+                }
+            }
+        }
+
+        ASSERT(fn_statement);
+        auto &[identifier, _] = fn_statement->params[i];
+        this->read_only_slices.push_back({this->compilation_unit, expression->args[i], fn_statement,
+                                          fn_statement->compilation_unit->get_token_string_from_index(identifier)});
+    }
+
     expression->type_info = fn_type_info->return_type;
 }
 
 void TypeChecker::type_check_identifier_expression(IdentifierExpression *expression) {
     TypeInfo *type_info = this->get_from_scope(expression->identifier);
+
+    // vector type names can be used for their builtin fns, f32x4.load(...)
+    if (type_info == NULL) {
+        TypeInfo *named_type_info = this->compilation_unit->get_type_from_scope(expression->identifier);
+        if (named_type_info != NULL && named_type_info->type == TypeInfoType::VECTOR) {
+            expression->type_info = new TypeTypeInfo(named_type_info);
+            expression->category  = ExpressionCategory::RVALUE;
+            return;
+        }
+    }
+
     if (type_info == NULL) {
         std::string identifier = this->compilation_unit->get_token_string_from_index(expression->identifier);
-        ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expression, NULL,
-                                                 NULL, NULL, std::format("unrecognized identifier \"{}\"", identifier));
+        this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expression,
+                                                        NULL, NULL, NULL,
+                                                        std::format("unrecognized identifier \"{}\"", identifier));
         return;
     }
 
@@ -832,14 +1498,20 @@ void TypeChecker::type_check_get_expression(GetExpression *expression) {
         std::string identifier       = this->compilation_unit->get_token_string_from_index(expression->member);
         TypeInfo   *member_type_info = namespace_compilation_unit->get_fn_from_scope_with_string(identifier);
 
-        if (member_type_info == NULL) {
-            ErrorReporter::report_type_checker_error(this->compilation_unit->file_data->absolute_path.string(),
-                                                     expression->lhs, NULL, NULL, NULL,
-                                                     std::format("no symbol '{}' found in namespace", identifier));
+        // builtin fns are in every file but are not part of their namespace
+        if (member_type_info == NULL || ((FnTypeInfo *)member_type_info)->is_builtin) {
+            this->error_reporter->report_type_checker_error(
+                this->compilation_unit->file_data->absolute_path.string(), expression->lhs, NULL, NULL, NULL,
+                std::format("no symbol '{}' found in namespace", identifier));
             return;
         }
 
         expression->type_info = member_type_info;
+        return;
+    }
+
+    if (expression->lhs->type_info->type == TypeInfoType::TYPE) {
+        return type_check_vector_type_member(expression, (TypeTypeInfo *)expression->lhs->type_info);
     }
 
     TypeInfo *using_type = expression->lhs->type_info;
@@ -864,9 +1536,9 @@ void TypeChecker::type_check_get_expression(GetExpression *expression) {
         }
 
         if (member_type_info == NULL) {
-            ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expression,
-                                                     NULL, NULL, NULL,
-                                                     std::format("Cannot find member \"{}\" in struct", member_string));
+            this->error_reporter->report_type_checker_error(
+                compilation_unit->file_data->absolute_path.string(), expression, NULL, NULL, NULL,
+                std::format("Cannot find member \"{}\" in struct", member_string));
             return;
         }
 
@@ -886,12 +1558,28 @@ void TypeChecker::type_check_get_expression(GetExpression *expression) {
             .set_message(
                 std::format("can only use 'size' builtin member for static arrays '{}' does not exist", member_string))
             .set_expr_1(expression)
-            .report();
+            .report(this->error_reporter);
 
         return;
     }
 
-    if (using_type->type == TypeInfoType::SLICE) {
+    if (using_type->type == TypeInfoType::VECTOR) {
+        return type_check_vector_member(expression, (VectorTypeInfo *)using_type);
+    }
+
+    if (using_type->type == TypeInfoType::ARENA || using_type->type == TypeInfoType::POOL) {
+        return type_check_allocator_member(expression, using_type);
+    }
+
+    if (using_type->type == TypeInfoType::DYNAMIC_ARRAY) {
+        return type_check_dynamic_array_member(expression, (DynamicArrayTypeInfo *)using_type);
+    }
+
+    if (using_type->type == TypeInfoType::HASH_MAP) {
+        return type_check_hash_map_member(expression, (HashMapTypeInfo *)using_type);
+    }
+
+    if (using_type->type == TypeInfoType::SLICE) {
         SliceTypeInfo *slice_type_info = (SliceTypeInfo *)using_type;
         if (compare_string(member_string, "size")) {
             expression->type_info = this->compilation_unit->global_type_scope["i64"];
@@ -907,18 +1595,282 @@ void TypeChecker::type_check_get_expression(GetExpression *expression) {
             .set_message(
                 std::format("can only use 'size' builtin member for static arrays '{}' does not exist", member_string))
             .set_expr_1(expression)
-            .report();
+            .report(this->error_reporter);
 
         return;
     }
 
-    ErrorReporter::report_type_checker_error(this->compilation_unit->file_data->absolute_path.string(), expression->lhs,
-                                             NULL,
-                                             NULL, NULL,
-                                             "Cannot derive member from non struct/namespace/array/slice type");
+    this->error_reporter->report_type_checker_error(this->compilation_unit->file_data->absolute_path.string(),
+                                                    expression->lhs, NULL, NULL, NULL,
+                                                    "Cannot derive member from non struct/namespace/array/slice type");
     return;
 }
 
+void TypeChecker::type_check_allocator_member(GetExpression *expression, TypeInfo *allocator_type_info) {
+    std::string member_string  = this->compilation_unit->get_token_string_from_index(expression->member);
+    TypeInfo   *void_type_info = this->compilation_unit->global_type_scope["void"];
+
+    // every builtin fn changes the allocator so none can be used on a shared one
+    if (this->parallel_scope_depth > 0 && is_shared_in_parallel_for(expression->lhs)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot use an arena or pool from outside a for par, they are not thread safe")
+            .set_expr_1(expression)
+            .report(this->error_reporter);
+        return;
+    }
+
+    if (allocator_type_info->type == TypeInfoType::ARENA) {
+        // arena.reset() --> everything allocated is gone, the memory is kept for reuse
+        if (compare_string(member_string, "reset")) {
+            expression->type_info = new FnTypeInfo(void_type_info, {});
+            return;
+        }
+
+        // arena.used() --> bytes allocated since the last reset
+        if (compare_string(member_string, "used")) {
+            expression->type_info = new FnTypeInfo(this->compilation_unit->global_type_scope["i64"], {});
+            return;
+        }
+
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message(std::format("arenas only have 'reset' and 'used' builtin fns, '{}' does not exist",
+                                     member_string))
+            .set_expr_1(expression)
+            .report(this->error_reporter);
+        return;
+    }
+
+    // pool.free(value) --> the slot value was in can be used by the next new(pool)
+    if (compare_string(member_string, "free")) {
+        TypeInfo *base_type   = ((PoolTypeInfo *)allocator_type_info)->base_type;
+        expression->type_info = new FnTypeInfo(void_type_info, {new PointerTypeInfo(base_type)});
+        return;
+    }
+
+    TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+        .set_message(std::format("pools only have a 'free' builtin fn, '{}' does not exist", member_string))
+        .set_expr_1(expression)
+        .report(this->error_reporter);
+}
+
+void TypeChecker::type_check_dynamic_array_member(GetExpression        *expression,
+                                                  DynamicArrayTypeInfo *dynamic_array_type_info) {
+    std::string member_string  = this->compilation_unit->get_token_string_from_index(expression->member);
+    TypeInfo   *base_type      = dynamic_array_type_info->base_type;
+    TypeInfo   *void_type_info = this->compilation_unit->global_type_scope["void"];
+    TypeInfo   *i64_type_info  = this->compilation_unit->global_type_scope["i64"];
+
+    // these are only read, the fns change them
+    if (compare_string(member_string, "size") || compare_string(member_string, "capacity")) {
+        expression->type_info = i64_type_info;
+        expression->category  = ExpressionCategory::RVALUE;
+        return;
+    }
+
+    // the rest change the array so they can not be used on a shared one, writing
+    // to its elements is fine the same as with slices
+    if (this->parallel_scope_depth > 0 && is_shared_in_parallel_for(expression->lhs)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot change a dynamic array from outside a for par, only its values can be assigned to")
+            .set_expr_1(expression)
+            .report(this->error_reporter);
+        return;
+    }
+
+    // array.push(value) --> adds value to the end, growing if it is full
+    if (compare_string(member_string, "push")) {
+        expression->type_info = new FnTypeInfo(void_type_info, {base_type});
+        return;
+    }
+
+    // array.pop() --> removes the last value and gives it back
+    if (compare_string(member_string, "pop")) {
+        expression->type_info = new FnTypeInfo(base_type, {});
+        return;
+    }
+
+    // array.reserve(n) --> makes room for n values so pushing up to n does not grow it
+    if (compare_string(member_string, "reserve")) {
+        expression->type_info = new FnTypeInfo(void_type_info, {i64_type_info});
+        return;
+    }
+
+    // array.clear() --> removes every value but keeps the memory
+    if (compare_string(member_string, "clear")) {
+        expression->type_info = new FnTypeInfo(void_type_info, {});
+        return;
+    }
+
+    // array.use_arena(&arena) --> the values are moved into the arena and it grows into it from now on
+    if (compare_string(member_string, "use_arena")) {
+        TypeInfo *arena_type_info = this->compilation_unit->global_type_scope["Arena"];
+        expression->type_info     = new FnTypeInfo(void_type_info, {new PointerTypeInfo(arena_type_info)});
+        return;
+    }
+
+    TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+        .set_message(std::format("dynamic arrays only have 'size', 'capacity', 'push', 'pop', 'reserve', 'clear' and "
+                                 "'use_arena' builtin members, '{}' does not exist",
+                                 member_string))
+        .set_expr_1(expression)
+        .report(this->error_reporter);
+}
+
+void TypeChecker::type_check_hash_map_member(GetExpression *expression, HashMapTypeInfo *hash_map_type_info) {
+    std::string member_string  = this->compilation_unit->get_token_string_from_index(expression->member);
+    TypeInfo   *key_type       = hash_map_type_info->key_type;
+    TypeInfo   *value_type     = hash_map_type_info->value_type;
+    TypeInfo   *void_type_info = this->compilation_unit->global_type_scope["void"];
+    TypeInfo   *bool_type_info = this->compilation_unit->global_type_scope["bool"];
+
+    if (compare_string(member_string, "size")) {
+        expression->type_info = this->compilation_unit->global_type_scope["i64"];
+        expression->category  = ExpressionCategory::RVALUE;
+        return;
+    }
+
+    // map.find(key) --> pointer to the value for key or null if it is not in the map
+    if (compare_string(member_string, "find")) {
+        expression->type_info = new FnTypeInfo(new PointerTypeInfo(value_type), {key_type});
+        return;
+    }
+
+    // map.contains(key) --> true if key is in the map
+    if (compare_string(member_string, "contains")) {
+        expression->type_info = new FnTypeInfo(bool_type_info, {key_type});
+        return;
+    }
+
+    // looking up values in a shared map is fine as long as nothing changes it
+    if (this->parallel_scope_depth > 0 && is_shared_in_parallel_for(expression->lhs)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot change a hash map from outside a for par, only 'find', 'contains' and 'size' can "
+                         "be used")
+            .set_expr_1(expression)
+            .report(this->error_reporter);
+        return;
+    }
+
+    // map.insert(key, value) --> adds key or replaces its value if it is already in the map
+    if (compare_string(member_string, "insert")) {
+        expression->type_info = new FnTypeInfo(void_type_info, {key_type, value_type});
+        return;
+    }
+
+    // map.erase(key) --> removes key, false if it was not in the map
+    if (compare_string(member_string, "erase")) {
+        expression->type_info = new FnTypeInfo(bool_type_info, {key_type});
+        return;
+    }
+
+    // map.reserve(n) --> makes room for n keys so inserting up to n does not grow it
+    if (compare_string(member_string, "reserve")) {
+        expression->type_info = new FnTypeInfo(void_type_info, {this->compilation_unit->global_type_scope["i64"]});
+        return;
+    }
+
+    // map.clear() --> removes every key but keeps the memory
+    if (compare_string(member_string, "clear")) {
+        expression->type_info = new FnTypeInfo(void_type_info, {});
+        return;
+    }
+
+    TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+        .set_message(std::format("hash maps only have 'size', 'find', 'contains', 'insert', 'erase', 'reserve' and "
+                                 "'clear' builtin members, '{}' does not exist",
+                                 member_string))
+        .set_expr_1(expression)
+        .report(this->error_reporter);
+}
+
+void TypeChecker::type_check_vector_type_member(GetExpression *expression, TypeTypeInfo *type_type_info) {
+    VectorTypeInfo *vector_type_info = (VectorTypeInfo *)type_type_info->of;
+    std::string     member_string    = this->compilation_unit->get_token_string_from_index(expression->member);
+    TypeInfo       *slice_type_info  = new SliceTypeInfo(vector_type_info->base_type);
+    TypeInfo       *i64_type_info    = this->compilation_unit->global_type_scope["i64"];
+
+    // f32x4.make(1.0f32, 2.0f32, 3.0f32, 4.0f32)
+    if (compare_string(member_string, "make")) {
+        auto args             = std::vector<TypeInfo *>(vector_type_info->lanes, vector_type_info->base_type);
+        expression->type_info = new FnTypeInfo(vector_type_info, args);
+        return;
+    }
+
+    // f32x4.splat(1.0f32) --> every lane is 1.0
+    if (compare_string(member_string, "splat")) {
+        expression->type_info = new FnTypeInfo(vector_type_info, {vector_type_info->base_type});
+        return;
+    }
+
+    // f32x4.load(values, i) --> values[i] to values[i + 3]
+    if (compare_string(member_string, "load")) {
+        expression->type_info = new FnTypeInfo(vector_type_info, {slice_type_info, i64_type_info});
+        return;
+    }
+
+    TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+        .set_message(std::format("vector types only have 'make', 'splat' and 'load' builtin fns, '{}' does not exist",
+                                 member_string))
+        .set_expr_1(expression)
+        .report(this->error_reporter);
+}
+
+void TypeChecker::type_check_vector_member(GetExpression *expression, VectorTypeInfo *vector_type_info) {
+    std::string member_string = this->compilation_unit->get_token_string_from_index(expression->member);
+    TypeInfo   *base_type     = vector_type_info->base_type;
+    TypeInfo   *mask_type     = vector_mask_type(vector_type_info);
+    bool        is_integer    = vector_type_info->base_type->number_type != NumberType::FLOAT;
+
+    if (compare_string(member_string, "size")) {
+        expression->type_info = this->compilation_unit->global_type_scope["i64"];
+        return;
+    }
+
+    // horizontal reductions across the lanes
+    if (compare_string(member_string, "sum") || compare_string(member_string, "min") ||
+        compare_string(member_string, "max")) {
+        expression->type_info = new FnTypeInfo(base_type, {});
+        return;
+    }
+
+    // v.store(values, i) --> values[i] to values[i + 3] = v
+    if (compare_string(member_string, "store")) {
+        TypeInfo *void_type_info = this->compilation_unit->global_type_scope["void"];
+        TypeInfo *i64_type_info  = this->compilation_unit->global_type_scope["i64"];
+        expression->type_info    = new FnTypeInfo(void_type_info, {new SliceTypeInfo(base_type), i64_type_info});
+        return;
+    }
+
+    // v.shuffle(indices) --> lane i is v[indices[i]]
+    if (compare_string(member_string, "shuffle")) {
+        expression->type_info = new FnTypeInfo(vector_type_info, {mask_type});
+        return;
+    }
+
+    // v.select(mask, other) --> lane i is v[i] where mask[i] is set else other[i]
+    if (compare_string(member_string, "select")) {
+        expression->type_info = new FnTypeInfo(vector_type_info, {mask_type, vector_type_info});
+        return;
+    }
+
+    // mask.any() mask.all() --> if any or all lanes are set
+    if (is_integer && (compare_string(member_string, "any") || compare_string(member_string, "all"))) {
+        expression->type_info = new FnTypeInfo(this->compilation_unit->global_type_scope["bool"], {});
+        return;
+    }
+
+    TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+        .set_message(std::format("'{}' is not a builtin member of vectors", member_string))
+        .set_expr_1(expression)
+        .report(this->error_reporter);
+}
+
+TypeInfo *TypeChecker::vector_mask_type(VectorTypeInfo *vector_type_info) {
+    // the signed integer vector with the same lane size and count, f32x4 --> i32x4
+    u64 lane_bits = number_size_bytes(vector_type_info->base_type->size) * 8;
+    return this->compilation_unit->global_type_scope[std::format("i{}x{}", lane_bits, vector_type_info->lanes)];
+}
+
 void TypeChecker::type_check_group_expression(GroupExpression *expression) {
     TRY_CALL_VOID(type_check_expression(expression->sub_expression));
     expression->type_info = expression->sub_expression->type_info;
@@ -931,7 +1883,7 @@ void TypeChecker::type_check_null_literal_expression(NullLiteralExpression *expr
 }
 
 void TypeChecker::type_check_zero_literal_expression(ZeroLiteralExpression *expression) {
-    expression->type_info = new AnyTypeInfo{TypeInfoType::ANY};
+    expression->type_info = new AnyTypeInfo();
     expression->category  = ExpressionCategory::RVALUE;
 }
 
@@ -942,8 +1894,9 @@ void TypeChecker::type_check_struct_instance_expression(StructInstanceExpression
     TypeInfo *type_info = expression->type_expression->type_info;
     // check it's a struct
     if (type_info->type != TypeInfoType::STRUCT) {
-        ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expression, NULL,
-                                                 NULL, NULL, "Can only use struct types in new expression");
+        this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expression,
+                                                        NULL, NULL, NULL,
+                                                        "Can only use struct types in new expression");
         return;
     }
 
@@ -954,12 +1907,13 @@ void TypeChecker::type_check_struct_instance_expression(StructInstanceExpression
     for (auto [name_token_index, expr] : expression->named_expressions) {
         std::string name = this->compilation_unit->get_token_string_from_index(name_token_index);
         TRY_CALL_VOID(type_check_expression(expr));
+        TRY_CALL_VOID(type_check_copy(expr));
         calling_args_type_infos.emplace_back(name, expr->type_info);
     }
 
     // check counts
     if (struct_type_info->members.size() != calling_args_type_infos.size()) {
-        ErrorReporter::report_type_checker_error(
+        this->error_reporter->report_type_checker_error(
             compilation_unit->file_data->absolute_path.string(), expression, NULL, NULL, NULL,
             std::format("Incorrect number of arguments in new expression, expected {} got {}",
                         struct_type_info->members.size(), calling_args_type_infos.size()));
@@ -976,13 +1930,68 @@ void TypeChecker::type_check_struct_instance_expression(StructInstanceExpression
 
         if (expression_member != member) {
             auto [name, expr] = expression->named_expressions.at(i);
-            ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expr, NULL,
-                                                     NULL, NULL, "Incorrect name specifier in new expression");
+            this->error_reporter->report_type_checker_error(compilation_unit->file_data->absolute_path.string(), expr,
+                                                            NULL, NULL, NULL,
+                                                            "Incorrect name specifier in new expression");
             return;
         }
     }
 
-    expression->type_info = struct_type_info;
+    if (expression->allocator == NULL) {
+        expression->type_info = struct_type_info;
+        return;
+    }
+
+    // the value is made then copied into the allocator
+    if (!can_copy(struct_type_info)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot allocate a struct holding an arena or pool, it would be copied")
+            .set_expr_1(expression)
+            .report(this->error_reporter);
+        return;
+    }
+
+    // new(allocator) T{...} --> ^T
+    TypeInfo *allocator_type_info = TRY_CALL_VOID(type_check_allocator(expression->allocator));
+    if (allocator_type_info->type == TypeInfoType::POOL &&
+        !type_match(((PoolTypeInfo *)allocator_type_info)->base_type, struct_type_info)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("pool is for a different type than the one being made")
+            .set_expr_1(expression->allocator)
+            .set_type_expr_1(expression->type_expression)
+            .report(this->error_reporter);
+        return;
+    }
+
+    expression->type_info = new PointerTypeInfo(struct_type_info);
+}
+
+TypeInfo *TypeChecker::type_check_allocator(Expression *allocator) {
+    // an arena or pool or a pointer to one, gives the arena or pool type
+    TRY_CALL_RET(type_check_expression(allocator));
+
+    TypeInfo *allocator_type_info = allocator->type_info;
+    if (allocator_type_info->type == TypeInfoType::POINTER) {
+        allocator_type_info = ((PointerTypeInfo *)allocator_type_info)->to;
+    }
+
+    if (allocator_type_info->type != TypeInfoType::ARENA && allocator_type_info->type != TypeInfoType::POOL) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("can only allocate into an Arena or Pool[T] or a pointer to one")
+            .set_expr_1(allocator)
+            .report(this->error_reporter);
+        return NULL;
+    }
+
+    if (this->parallel_scope_depth > 0 && is_shared_in_parallel_for(allocator)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot allocate from an arena or pool from outside a for par, they are not thread safe")
+            .set_expr_1(allocator)
+            .report(this->error_reporter);
+        return NULL;
+    }
+
+    return allocator_type_info;
 }
 
 void TypeChecker::type_check_static_array_literal_expression(StaticArrayExpression *expression) {
@@ -997,19 +2006,20 @@ void TypeChecker::type_check_static_array_literal_expression(StaticArrayExpressi
                                      expression->expressions.size()))
             .set_expr_1(expression->number)
             .set_type_expr_1(expression->type_expression)
-            .report();
+            .report(this->error_reporter);
 
         return;
     }
 
     for (Expression *expr : expression->expressions) {
         TRY_CALL_VOID(type_check_expression(expr));
+        TRY_CALL_VOID(type_check_copy(expr));
         if (!type_match(expression->type_expression->type_info, expr->type_info)) {
             TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
                 .set_message("mistmaatched types in static array literal")
                 .set_expr_1(expr)
                 .set_type_expr_1(expression->type_expression)
-                .report();
+                .report(this->error_reporter);
 
             return;
         }
@@ -1024,12 +2034,14 @@ void TypeChecker::type_check_subscript_expression(SubscriptExpression *expressio
     TRY_CALL_VOID(type_check_expression(expression->subscripter));
 
     if (expression->subscriptee->type_info->type != TypeInfoType::STATIC_ARRAY &&
-        expression->subscriptee->type_info->type != TypeInfoType::SLICE) {
+        expression->subscriptee->type_info->type != TypeInfoType::SLICE &&
+        expression->subscriptee->type_info->type != TypeInfoType::VECTOR &&
+        expression->subscriptee->type_info->type != TypeInfoType::DYNAMIC_ARRAY) {
         TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
-            .set_message("can only subscript array and slice types")
+            .set_message("can only subscript array, slice and vector types")
             .set_expr_1(expression->subscriptee)
             .set_expr_2(expression->subscripter)
-            .report();
+            .report(this->error_reporter);
 
         return;
     }
@@ -1039,12 +2051,46 @@ void TypeChecker::type_check_subscript_expression(SubscriptExpression *expressio
         TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
             .set_message("can only subscript with number and range expressions")
             .set_expr_2(expression->subscripter)
-            .report();
+            .report(this->error_reporter);
+
+        return;
+    }
+
+    // embedded files are in read only memory so nothing can be given that could write to them,
+    // they have to be copied into a let first
+    if (expression->subscripter->type_info->type == TypeInfoType::RANGE &&
+        is_in_packed_member(this->compilation_unit, expression->subscriptee)) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("cannot slice a #packed member, it might not be aligned, copy it into a let first")
+            .set_expr_1(expression->subscriptee)
+            .report(this->error_reporter);
+        return;
+    }
 
+    if (expression->subscripter->type_info->type == TypeInfoType::RANGE && is_embedded(expression->subscriptee) &&
+        expression != this->read_only_slice_expression) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("an embedded file is read only, it can only be sliced in a let, a fn arg, a for or a print")
+            .set_expr_1(expression->subscriptee)
+            .report(this->error_reporter);
         return;
     }
 
-    if (expression->subscripter->type_info->type == TypeInfoType::NUMBER) {
+    // lanes of a vector can be read but not assigned to, they are not lvalues
+    // in c++ and they can not be sliced
+    if (expression->subscriptee->type_info->type == TypeInfoType::VECTOR) {
+        if (expression->subscripter->type_info->type == TypeInfoType::RANGE) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message("cannot slice a vector, use store to copy it to a slice")
+                .set_expr_1(expression->subscriptee)
+                .set_expr_2(expression->subscripter)
+                .report(this->error_reporter);
+
+            return;
+        }
+
+        expression->category = ExpressionCategory::RVALUE;
+    } else if (expression->subscripter->type_info->type == TypeInfoType::NUMBER) {
         // this maybe wrong, what if we are subscripting a r-value??
         // e.g. [3]i64{1, 2, 4}[0] = 3;
         // this shouldn't work right??
@@ -1067,6 +2113,10 @@ void TypeChecker::type_check_subscript_expression(SubscriptExpression *expressio
     } else if (expression->subscriptee->type_info->type == TypeInfoType::SLICE) {
         SliceTypeInfo *slice_type_info = (SliceTypeInfo *)expression->subscriptee->type_info;
         base_type                      = slice_type_info->base_type;
+    } else if (expression->subscriptee->type_info->type == TypeInfoType::VECTOR) {
+        base_type = ((VectorTypeInfo *)expression->subscriptee->type_info)->base_type;
+    } else if (expression->subscriptee->type_info->type == TypeInfoType::DYNAMIC_ARRAY) {
+        base_type = ((DynamicArrayTypeInfo *)expression->subscriptee->type_info)->base_type;
     }
 
     { // when the subscripter is a number
@@ -1076,7 +2126,7 @@ void TypeChecker::type_check_subscript_expression(SubscriptExpression *expressio
                 TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
                     .set_message("cannot use a float type to subscript an array")
                     .set_expr_2(expression->subscripter)
-                    .report();
+                    .report(this->error_reporter);
 
                 return;
             }
@@ -1112,7 +2162,7 @@ void TypeChecker::type_check_range_expression(RangeExpression *expression) {
         TypeCheckerError::make(this->compilation_unit->file_data->absolute_path.string())
             .set_message("range expression can only use non-float number types")
             .set_expr_1(expr)
-            .report();
+            .report(this->error_reporter);
         return false;
     };
 
@@ -1131,6 +2181,92 @@ void TypeChecker::type_check_range_expression(RangeExpression *expression) {
     expression->type_info = new RangeTypeInfo();
 }
 
+void TypeChecker::type_check_arena_slice_expression(ArenaSliceExpression *expression) {
+    expression->category = ExpressionCategory::RVALUE;
+
+    TypeInfo *allocator_type_info = TRY_CALL_VOID(type_check_allocator(expression->arena));
+    if (allocator_type_info->type != TypeInfoType::ARENA) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("arena_slice needs an Arena, pools can only hold single values")
+            .set_expr_1(expression->arena)
+            .report(this->error_reporter);
+        return;
+    }
+
+    TRY_CALL_VOID(type_check_type_expression(expression->type_expression));
+    TRY_CALL_VOID(type_check_expression(expression->count));
+    if (expression->count->type_info->type != TypeInfoType::NUMBER ||
+        ((NumberTypeInfo *)expression->count->type_info)->number_type == NumberType::FLOAT) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("count of an arena_slice must be a non-float number")
+            .set_expr_1(expression->count)
+            .report(this->error_reporter);
+        return;
+    }
+
+    expression->type_info = new SliceTypeInfo(expression->type_expression->type_info);
+}
+
+void TypeChecker::type_check_embed_expression(EmbedExpression *expression) {
+    // the same as imports the path is relative to the file it is in
+    std::string path = this->compilation_unit->get_token_string_from_index(expression->path);
+    trim(path, "\"");
+    std::filesystem::path absolute_path = this->compilation_unit->file_data->absolute_path.parent_path() / path;
+
+    std::error_code error_code;
+    u64             byte_size = std::filesystem::file_size(absolute_path, error_code);
+    if (error_code) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message(std::format("cannot embed '{}', {}", absolute_path.string(), error_code.message()))
+            .set_expr_1(expression)
+            .report(this->error_reporter);
+        return;
+    }
+
+    TypeInfo *element_type_info = this->compilation_unit->global_type_scope["u8"];
+    if (expression->element_type != NULL) {
+        TRY_CALL_VOID(type_check_type_expression(expression->element_type));
+        element_type_info = expression->element_type->type_info;
+    }
+
+    if (element_type_info->type != TypeInfoType::NUMBER) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("embedded files can only be used as arrays of numbers")
+            .set_type_expr_1(expression->element_type)
+            .report(this->error_reporter);
+        return;
+    }
+
+    u64 element_size = type_size(element_type_info);
+    if (byte_size == 0 || byte_size % element_size != 0) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message(std::format("cannot embed '{}', its size {} is not a multiple of {} bytes or is empty",
+                                     absolute_path.string(), byte_size, element_size))
+            .set_expr_1(expression)
+            .report(this->error_reporter);
+        return;
+    }
+
+    expression->absolute_path = absolute_path.lexically_normal().string();
+    expression->byte_size     = byte_size;
+
+    // it is the bytes in the executable so it can not be assigned to
+    expression->type_info = new StaticArrayTypeInfo(byte_size / element_size, element_type_info);
+    expression->category  = ExpressionCategory::RVALUE;
+
+    // a file embedded as the same type more than once, or in a generic fn, is only put in once
+    for (EmbedExpression *embedded : this->compilation_unit->embed_expressions) {
+        if (embedded->absolute_path == expression->absolute_path &&
+            type_id(embedded->type_info) == type_id(expression->type_info)) {
+            expression->index = embedded->index;
+            return;
+        }
+    }
+
+    expression->index = this->compilation_unit->embed_expressions.size();
+    this->compilation_unit->embed_expressions.push_back(expression);
+}
+
 void TypeChecker::type_check_type_expression(TypeExpression *type_expression) {
     switch (type_expression->type) {
     case TypeExpressionType::TYPE_IDENTIFIER:
@@ -1148,6 +2284,15 @@ void TypeChecker::type_check_type_expression(TypeExpression *type_expression) {
     case TypeExpressionType::TYPE_SLICE:
         type_check_slice_type_expression(static_cast<SliceTypeExpression *>(type_expression));
         break;
+    case TypeExpressionType::TYPE_POOL:
+        type_check_pool_type_expression(static_cast<PoolTypeExpression *>(type_expression));
+        break;
+    case TypeExpressionType::TYPE_DYNAMIC_ARRAY:
+        type_check_dynamic_array_type_expression(static_cast<DynamicArrayTypeExpression *>(type_expression));
+        break;
+    case TypeExpressionType::TYPE_HASH_MAP:
+        type_check_hash_map_type_expression(static_cast<HashMapTypeExpression *>(type_expression));
+        break;
     default:
         UNREACHABLE();
     }
@@ -1164,6 +2309,16 @@ void TypeChecker::type_check_unary_type_expression(UnaryTypeExpression *type_exp
 }
 
 void TypeChecker::type_check_identifier_type_expression(IdentifierTypeExpression *type_expression) {
+    // in a generic fn instance its generic params come first
+    std::string identifier = this->compilation_unit->get_token_string_from_index(type_expression->identifier);
+    for (auto &[name, generic_type_info] : this->generic_bindings) {
+        if (name == identifier) {
+            type_expression->type_info        = generic_type_info;
+            type_expression->is_generic_param = true;
+            return;
+        }
+    }
+
     // first checking the type table then checking any namespaces
     TypeInfo *type_info = this->compilation_unit->get_type_from_scope(type_expression->identifier);
     if (type_info == NULL) {
@@ -1171,7 +2326,7 @@ void TypeChecker::type_check_identifier_type_expression(IdentifierTypeExpression
     }
 
     if (type_info == NULL) {
-        ErrorReporter::report_type_checker_error(
+        this->error_reporter->report_type_checker_error(
             compilation_unit->file_data->absolute_path.string(), NULL, NULL, type_expression, NULL,
             "unrecognised identifier in type expression, no type or namespace exists with this name");
         return;
@@ -1183,9 +2338,9 @@ void TypeChecker::type_check_identifier_type_expression(IdentifierTypeExpression
 void TypeChecker::type_check_get_type_expression(GetTypeExpression *type_expression) {
     TRY_CALL_VOID(type_check_type_expression(type_expression->type_expression));
     if (type_expression->type_expression->type_info->type != TypeInfoType::NAMESPACE) {
-        ErrorReporter::report_type_checker_error(compilation_unit->file_data->absolute_path.string(), NULL, NULL,
-                                                 type_expression->type_expression, NULL,
-                                                 "can only use '.' on namespace identifiers in type expressions");
+        this->error_reporter->report_type_checker_error(
+            compilation_unit->file_data->absolute_path.string(), NULL, NULL, type_expression->type_expression, NULL,
+            "can only use '.' on namespace identifiers in type expressions");
         return;
     }
 
@@ -1199,9 +2354,9 @@ void TypeChecker::type_check_get_type_expression(GetTypeExpression *type_express
     TypeInfo   *type_info  = other_compilation_unit->get_type_from_scope_with_string(identifier);
 
     if (type_info == NULL) {
-        ErrorReporter::report_type_checker_error(this->compilation_unit->file_data->absolute_path.string(), NULL, NULL,
-                                                 type_expression->type_expression, NULL,
-                                                 std::format("no symbol '{}' found in namespace", identifier));
+        this->error_reporter->report_type_checker_error(this->compilation_unit->file_data->absolute_path.string(), NULL,
+                                                        NULL, type_expression->type_expression, NULL,
+                                                        std::format("no symbol '{}' found in namespace", identifier));
         return;
     }
 
@@ -1223,6 +2378,393 @@ void TypeChecker::type_check_slice_type_expression(SliceTypeExpression *type_exp
     type_expression->type_info = new SliceTypeInfo(type_expression->base_type->type_info);
 }
 
+void TypeChecker::type_check_pool_type_expression(PoolTypeExpression *type_expression) {
+    TRY_CALL_VOID(type_check_type_expression(type_expression->base_type));
+    this->element_type_expressions.push_back({this->compilation_unit, type_expression->base_type});
+
+    type_expression->type_info = new PoolTypeInfo(type_expression->base_type->type_info);
+}
+
+void TypeChecker::type_check_dynamic_array_type_expression(DynamicArrayTypeExpression *type_expression) {
+    TRY_CALL_VOID(type_check_type_expression(type_expression->base_type));
+    this->element_type_expressions.push_back({this->compilation_unit, type_expression->base_type});
+
+    type_expression->type_info = new DynamicArrayTypeInfo(type_expression->base_type->type_info);
+}
+
+void TypeChecker::type_check_hash_map_type_expression(HashMapTypeExpression *type_expression) {
+    TRY_CALL_VOID(type_check_type_expression(type_expression->key_type));
+    TRY_CALL_VOID(type_check_type_expression(type_expression->value_type));
+
+    // the key might be a struct whose members are not typed yet, so whether it can
+    // be hashed is checked once everything else is
+    this->hash_map_type_expressions.push_back({this->compilation_unit, type_expression});
+    this->element_type_expressions.push_back({this->compilation_unit, type_expression->key_type});
+    this->element_type_expressions.push_back({this->compilation_unit, type_expression->value_type});
+    type_expression->type_info =
+        new HashMapTypeInfo(type_expression->key_type->type_info, type_expression->value_type->type_info);
+}
+
+void TypeChecker::type_check_hash_map_keys() {
+    for (auto &[compilation_unit, type_expression] : this->hash_map_type_expressions) {
+        if (mark_hash_key(type_expression->key_type->type_info)) {
+            continue;
+        }
+
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("hash map keys must be numbers, bools, pointers, strings, slices of keys or structs of keys")
+            .set_type_expr_1(type_expression->key_type)
+            .report(this->error_reporter);
+        return;
+    }
+}
+
+void TypeChecker::type_check_element_types() {
+    // containers copy their values into place when they grow or are copied
+    for (auto &[compilation_unit, type_expression] : this->element_type_expressions) {
+        if (can_copy(type_expression->type_info)) {
+            continue;
+        }
+
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message("arenas and pools cannot be copied so cannot be held in a [dyn]T, HashMap or Pool[T], use "
+                         "a pointer to one instead")
+            .set_type_expr_1(type_expression)
+            .report(this->error_reporter);
+        return;
+    }
+}
+
+void TypeChecker::type_check_read_only_slices() {
+    // nothing in the fn can write through the name or copy it somewhere else that could
+    for (auto &[compilation_unit, expression, fn_statement, identifier] : this->read_only_slices) {
+        MutationAnalysis mutation_analysis = MutationAnalysis(fn_statement->compilation_unit, {identifier});
+        mutation_analysis.track_copies     = true;
+        if (!mutation_analysis.might_mutate_statement(fn_statement->body)) {
+            continue;
+        }
+
+        CompilationUnit *fn_unit       = fn_statement->compilation_unit;
+        std::string      fn_identifier = fn_unit->get_token_string_from_index(fn_statement->identifier);
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message(std::format("an embedded file is read only but '{}' might write through or copy '{}'",
+                                     fn_identifier, identifier))
+            .set_expr_1(expression)
+            .report(this->error_reporter);
+        return;
+    }
+}
+
+bool TypeChecker::mark_hash_key(TypeInfo *type_info) {
+    switch (type_info->type) {
+    case TypeInfoType::NUMBER:
+    case TypeInfoType::BOOLEAN:
+    case TypeInfoType::POINTER:
+    case TypeInfoType::STRING:
+        return true;
+    case TypeInfoType::SLICE:
+        return mark_hash_key(((SliceTypeInfo *)type_info)->base_type);
+    case TypeInfoType::STRUCT: {
+        // every struct member has to be a key too as the hash fn is made from theirs
+        auto struct_type_info = (StructTypeInfo *)type_info;
+        if (struct_type_info->is_hash_key) {
+            return true;
+        }
+
+        for (auto &[_, member_type_info] : struct_type_info->members) {
+            if (!mark_hash_key(member_type_info)) {
+                return false;
+            }
+        }
+
+        struct_type_info->is_hash_key = true;
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+// the names of the generic params of an instance next to the types they were given
+static std::vector<std::tuple<std::string, TypeInfo *>> generic_bindings_of(FnStatement *instance) {
+    auto bindings = std::vector<std::tuple<std::string, TypeInfo *>>();
+    for (u64 i = 0; i < instance->generic_params.size(); i++) {
+        std::string name = instance->compilation_unit->get_token_string_from_index(instance->generic_params[i]);
+        bindings.push_back({name, instance->generic_arguments[i]});
+    }
+
+    return bindings;
+}
+
+FnStatement *TypeChecker::instantiate_generic_fn(FnStatement *generic_statement, CallExpression *expression,
+                                                 std::vector<TypeInfo *> arg_type_infos) {
+    CompilationUnit *generic_compilation_unit = generic_statement->compilation_unit;
+    std::string      identifier = generic_compilation_unit->get_token_string_from_index(generic_statement->identifier);
+
+    if (generic_statement->params.size() != arg_type_infos.size()) {
+        this->error_reporter->report_type_checker_error(
+            compilation_unit->file_data->absolute_path.string(), expression->callee, NULL, NULL, NULL,
+            std::format("incorrect number of arguments in call expression, expected {} got {}",
+                        generic_statement->params.size(), arg_type_infos.size()));
+        return NULL;
+    }
+
+    // the generic params are worked out from the types of the args, max(1, 2) --> T = i64
+    auto generic_arguments = std::vector<TypeInfo *>(generic_statement->generic_params.size(), NULL);
+    for (u64 i = 0; i < generic_statement->params.size(); i++) {
+        auto &[_, param_type_expression] = generic_statement->params[i];
+        if (!infer_generic_arguments(generic_statement, param_type_expression, arg_type_infos[i],
+                                     generic_arguments)) {
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message(std::format("conflicting types given for the generic params of '{}'", identifier))
+                .set_expr_1(expression->args[i])
+                .report(this->error_reporter);
+            return NULL;
+        }
+    }
+
+    auto type_ids = std::vector<u64>();
+    for (u64 i = 0; i < generic_arguments.size(); i++) {
+        if (generic_arguments[i] == NULL) {
+            std::string name =
+                generic_compilation_unit->get_token_string_from_index(generic_statement->generic_params[i]);
+            TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+                .set_message(std::format("cannot work out generic param '{}' of '{}' from the args", name, identifier))
+                .set_expr_1(expression->callee)
+                .report(this->error_reporter);
+            return NULL;
+        }
+
+        type_ids.push_back(type_id(generic_arguments[i]));
+    }
+
+    // every call with the same types shares one instance
+    auto key   = std::make_tuple(generic_statement, type_ids);
+    auto found = this->generic_instances.find(key);
+    if (found != this->generic_instances.end()) {
+        return found->second;
+    }
+
+    if (this->generic_depth + 1 > MAX_GENERIC_DEPTH) {
+        TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
+            .set_message(std::format("generic fn '{}' made more than {} instances deep, it might be making a new "
+                                     "instance of itself every call",
+                                     identifier, MAX_GENERIC_DEPTH))
+            .set_expr_1(expression->callee)
+            .report(this->error_reporter);
+        return NULL;
+    }
+
+    // each instance is parsed again from the tokens of the generic fn so it gets its own tree
+    // to type, the generic fn was already parsed without errors so this cannot fail
+    Parser parser               = Parser(generic_compilation_unit, this->error_reporter);
+    parser.current              = generic_statement->fn_token;
+    FnStatement *instance       = parser.eval_fn_statement(generic_statement->tags);
+    ASSERT(instance != NULL);
+    instance->generic_arguments = generic_arguments;
+    instance->instance_index    = generic_compilation_unit->generic_fn_instances.size();
+    instance->generic_depth     = this->generic_depth + 1;
+    instance->type_info         = new FnTypeInfo(NULL, {});
+
+    generic_compilation_unit->generic_fn_instances.push_back(instance);
+    this->generic_instances[key] = instance;
+
+    // the decl is typed now so the caller knows what it returns, the body is typed later
+    CompilationUnit *calling_compilation_unit = this->compilation_unit;
+    auto             calling_bindings         = this->generic_bindings;
+    this->compilation_unit                    = generic_compilation_unit;
+    this->generic_bindings                    = generic_bindings_of(instance);
+    type_check_fn_decl(instance);
+    this->compilation_unit = calling_compilation_unit;
+    this->generic_bindings = calling_bindings;
+
+    if (this->error_reporter->has_error_since_last_check()) {
+        return NULL;
+    }
+
+    this->generic_instances_to_check.push_back(instance);
+    return instance;
+}
+
+bool TypeChecker::infer_generic_arguments(FnStatement *generic_statement, TypeExpression *param_type_expression,
+                                          TypeInfo *arg_type_info, std::vector<TypeInfo *> &generic_arguments) {
+    // null and zero fit any type so they say nothing about the generic params
+    if (arg_type_info->type == TypeInfoType::ANY) {
+        return true;
+    }
+
+    if (arg_type_info->type == TypeInfoType::POINTER &&
+        ((PointerTypeInfo *)arg_type_info)->to->type == TypeInfoType::ANY) {
+        return true;
+    }
+
+    // walking the param type and the arg type together, if they do not have the same shape
+    // nothing is bound and the arg is reported as a mismatch once the instance is made
+    switch (param_type_expression->type) {
+    case TypeExpressionType::TYPE_IDENTIFIER: {
+        CompilationUnit *generic_compilation_unit = generic_statement->compilation_unit;
+        std::string      identifier               = generic_compilation_unit->get_token_string_from_index(
+            static_cast<IdentifierTypeExpression *>(param_type_expression)->identifier);
+
+        for (u64 i = 0; i < generic_statement->generic_params.size(); i++) {
+            if (generic_compilation_unit->get_token_string_from_index(generic_statement->generic_params[i]) !=
+                identifier) {
+                continue;
+            }
+
+            if (generic_arguments[i] == NULL) {
+                generic_arguments[i] = arg_type_info;
+                return true;
+            }
+
+            return type_match(generic_arguments[i], arg_type_info);
+        }
+
+        return true;
+    }
+    case TypeExpressionType::TYPE_UNARY: {
+        if (arg_type_info->type != TypeInfoType::POINTER) {
+            return true;
+        }
+
+        return infer_generic_arguments(generic_statement,
+                                       static_cast<UnaryTypeExpression *>(param_type_expression)->type_expression,
+                                       ((PointerTypeInfo *)arg_type_info)->to, generic_arguments);
+    }
+    case TypeExpressionType::TYPE_STATIC_ARRAY: {
+        if (arg_type_info->type != TypeInfoType::STATIC_ARRAY) {
+            return true;
+        }
+
+        return infer_generic_arguments(generic_statement,
+                                       static_cast<StaticArrayTypeExpression *>(param_type_expression)->base_type,
+                                       ((StaticArrayTypeInfo *)arg_type_info)->base_type, generic_arguments);
+    }
+    case TypeExpressionType::TYPE_SLICE: {
+        if (arg_type_info->type != TypeInfoType::SLICE) {
+            return true;
+        }
+
+        return infer_generic_arguments(generic_statement,
+                                       static_cast<SliceTypeExpression *>(param_type_expression)->base_type,
+                                       ((SliceTypeInfo *)arg_type_info)->base_type, generic_arguments);
+    }
+    case TypeExpressionType::TYPE_POOL: {
+        if (arg_type_info->type != TypeInfoType::POOL) {
+            return true;
+        }
+
+        return infer_generic_arguments(generic_statement,
+                                       static_cast<PoolTypeExpression *>(param_type_expression)->base_type,
+                                       ((PoolTypeInfo *)arg_type_info)->base_type, generic_arguments);
+    }
+    case TypeExpressionType::TYPE_DYNAMIC_ARRAY: {
+        if (arg_type_info->type != TypeInfoType::DYNAMIC_ARRAY) {
+            return true;
+        }
+
+        return infer_generic_arguments(generic_statement,
+                                       static_cast<DynamicArrayTypeExpression *>(param_type_expression)->base_type,
+                                       ((DynamicArrayTypeInfo *)arg_type_info)->base_type, generic_arguments);
+    }
+    case TypeExpressionType::TYPE_HASH_MAP: {
+        if (arg_type_info->type != TypeInfoType::HASH_MAP) {
+            return true;
+        }
+
+        auto hash_map_type_expression = static_cast<HashMapTypeExpression *>(param_type_expression);
+        auto hash_map_type_info       = (HashMapTypeInfo *)arg_type_info;
+        return infer_generic_arguments(generic_statement, hash_map_type_expression->key_type,
+                                       hash_map_type_info->key_type, generic_arguments) &&
+               infer_generic_arguments(generic_statement, hash_map_type_expression->value_type,
+                                       hash_map_type_info->value_type, generic_arguments);
+    }
+    default:
+        return true;
+    }
+}
+
+void TypeChecker::type_check_generic_instances() {
+    // checking the body of an instance can make new ones which are added to the end
+    for (u64 i = 0; i < this->generic_instances_to_check.size(); i++) {
+        FnStatement *instance  = this->generic_instances_to_check[i];
+        this->compilation_unit = instance->compilation_unit;
+        this->generic_bindings = generic_bindings_of(instance);
+        this->generic_depth    = instance->generic_depth;
+
+        TraceSpan fn_span =
+            TraceSpan(this->tracer, trace_name(this->tracer, instance->compilation_unit, instance), "type check");
+        TRY_CALL_VOID(type_check_fn_statement_full(instance));
+    }
+
+    this->generic_bindings.clear();
+    this->generic_depth = 0;
+}
+
+// the same type always gets the same id however many type infos are made for it, structs are
+// the same type only if they are the same type info as each one is only made once
+u64 TypeChecker::type_id(TypeInfo *type_info) {
+    std::string key;
+    switch (type_info->type) {
+    case TypeInfoType::NUMBER: {
+        auto number_type_info = (NumberTypeInfo *)type_info;
+        key = std::format("n{}_{}", (u64)number_type_info->number_type, (u64)number_type_info->size);
+    } break;
+    case TypeInfoType::BOOLEAN:
+        key = "b";
+        break;
+    case TypeInfoType::VOID:
+        key = "v";
+        break;
+    case TypeInfoType::ARENA:
+        key = "a";
+        break;
+    case TypeInfoType::POINTER:
+        key = std::format("^{}", type_id(((PointerTypeInfo *)type_info)->to));
+        break;
+    case TypeInfoType::SLICE:
+        key = std::format("[]{}", type_id(((SliceTypeInfo *)type_info)->base_type));
+        break;
+    case TypeInfoType::STATIC_ARRAY: {
+        auto static_array_type_info = (StaticArrayTypeInfo *)type_info;
+        key = std::format("[{}]{}", static_array_type_info->size, type_id(static_array_type_info->base_type));
+    } break;
+    case TypeInfoType::VECTOR: {
+        auto vector_type_info = (VectorTypeInfo *)type_info;
+        key = std::format("x{}_{}", vector_type_info->lanes, type_id(vector_type_info->base_type));
+    } break;
+    case TypeInfoType::POOL:
+        key = std::format("p{}", type_id(((PoolTypeInfo *)type_info)->base_type));
+        break;
+    case TypeInfoType::DYNAMIC_ARRAY:
+        key = std::format("d{}", type_id(((DynamicArrayTypeInfo *)type_info)->base_type));
+        break;
+    case TypeInfoType::HASH_MAP: {
+        auto hash_map_type_info = (HashMapTypeInfo *)type_info;
+        key = std::format("h{},{}", type_id(hash_map_type_info->key_type), type_id(hash_map_type_info->value_type));
+    } break;
+    case TypeInfoType::STRUCT: {
+        // hash map entries are made per map type so they are told apart by their members
+        auto struct_type_info = (StructTypeInfo *)type_info;
+        if (struct_type_info->defined_location != NULL) {
+            key = std::format("s{}", (void *)struct_type_info);
+            break;
+        }
+
+        key = "e";
+        for (auto &[_, member_type_info] : struct_type_info->members) {
+            key += std::format("{},", type_id(member_type_info));
+        }
+    } break;
+    default:
+        key = std::format("?{}", (void *)type_info);
+        break;
+    }
+
+    auto [it, _] = this->type_ids.try_emplace(key, this->type_ids.size());
+    return it->second;
+}
+
 bool type_match(TypeInfo *a, TypeInfo *b) {
 
     ASSERT_MSG(!(a->type == TypeInfoType::ANY && b->type == TypeInfoType::ANY), "Cannot compare 2 any types");
@@ -1239,8 +2781,8 @@ bool type_match(TypeInfo *a, TypeInfo *b) {
     if (b->type == TypeInfoType::ANY)
         return true;
 
-    if (a->type == TypeInfoType::VOID || a->type == TypeInfoType::BOOLEAN ||
-        a->type == TypeInfoType::STRING) { // values don't matter
+    if (a->type == TypeInfoType::VOID || a->type == TypeInfoType::BOOLEAN || a->type == TypeInfoType::STRING ||
+        a->type == TypeInfoType::ARENA) { // values don't matter
         return true;
     } else if (a->type == TypeInfoType::NUMBER) {
         auto int_a = static_cast<NumberTypeInfo *>(a);
@@ -1292,6 +2834,31 @@ bool type_match(TypeInfo *a, TypeInfo *b) {
         auto slice_b = static_cast<SliceTypeInfo *>(b);
 
         return type_match(slice_a->base_type, slice_b->base_type);
+    } else if (a->type == TypeInfoType::VECTOR) {
+        auto vector_a = static_cast<VectorTypeInfo *>(a);
+        auto vector_b = static_cast<VectorTypeInfo *>(b);
+
+        if (vector_a->lanes != vector_b->lanes) {
+            return false;
+        }
+
+        return type_match(vector_a->base_type, vector_b->base_type);
+    } else if (a->type == TypeInfoType::POOL) {
+        auto pool_a = static_cast<PoolTypeInfo *>(a);
+        auto pool_b = static_cast<PoolTypeInfo *>(b);
+
+        return type_match(pool_a->base_type, pool_b->base_type);
+    } else if (a->type == TypeInfoType::DYNAMIC_ARRAY) {
+        auto dynamic_array_a = static_cast<DynamicArrayTypeInfo *>(a);
+        auto dynamic_array_b = static_cast<DynamicArrayTypeInfo *>(b);
+
+        return type_match(dynamic_array_a->base_type, dynamic_array_b->base_type);
+    } else if (a->type == TypeInfoType::HASH_MAP) {
+        auto hash_map_a = static_cast<HashMapTypeInfo *>(a);
+        auto hash_map_b = static_cast<HashMapTypeInfo *>(b);
+
+        return type_match(hash_map_a->key_type, hash_map_b->key_type) &&
+               type_match(hash_map_a->value_type, hash_map_b->value_type);
     }
 
     UNREACHABLE();
@@ -1337,7 +2904,7 @@ void resolve_dependencies(std::vector<SortingNode>                  *nodes,
     }
 }
 
-void topological_visit(std::vector<SortingNode> *L, SortingNode *node) {
+void topological_visit(ErrorReporter *error_reporter, std::vector<SortingNode> *L, SortingNode *node) {
     if (node->permenent_mark)
         return;
 
@@ -1347,7 +2914,7 @@ void topological_visit(std::vector<SortingNode> *L, SortingNode *node) {
         TypeCheckerError::make(compilation_unit->file_data->absolute_path.string())
             .set_message(std::format("recursive type found in {}", compilation_unit->get_token_string_from_index(
                                                                        node->type_info->defined_location->identifier)))
-            .report();
+            .report(error_reporter);
 
         return;
     }
@@ -1355,7 +2922,7 @@ void topological_visit(std::vector<SortingNode> *L, SortingNode *node) {
     node->temperory_mark = true;
 
     for (SortingNode *child : node->depends_on) {
-        topological_visit(L, child);
+        topological_visit(error_reporter, L, child);
     }
 
     node->temperory_mark = false;
@@ -1363,7 +2930,7 @@ void topological_visit(std::vector<SortingNode> *L, SortingNode *node) {
     L->push_back(*node); // TODO maybe we dont need to do a copy here????
 }
 
-std::vector<SortingNode> topilogical_sort(std::vector<StructStatement *> statements) {
+std::vector<SortingNode> topilogical_sort(ErrorReporter *error_reporter, std::vector<StructStatement *> statements) {
     std::vector<SortingNode>                  nodes;
     std::unordered_map<StructTypeInfo *, u64> type_info_to_node_index_map;
 
@@ -1381,8 +2948,106 @@ std::vector<SortingNode> topilogical_sort(std::vector<StructStatement *> stateme
     // https://en.wikipedia.org/wiki/Topological_sorting
     std::vector<SortingNode> L;
     for (SortingNode &sorting_node : nodes) {
-        topological_visit(&L, &sorting_node);
+        topological_visit(error_reporter, &L, &sorting_node);
     }
 
     return L;
 }
+
+u64 type_size(TypeInfo *type_info) {
+    switch (type_info->type) {
+    case TypeInfoType::NUMBER:
+        return number_size_bytes(((NumberTypeInfo *)type_info)->size);
+    case TypeInfoType::BOOLEAN:
+        return 1;
+    case TypeInfoType::POINTER:
+        return sizeof(void *);
+    case TypeInfoType::SLICE:
+        // T *pointer, i64 size
+        return sizeof(void *) + 8;
+    case TypeInfoType::STATIC_ARRAY: {
+        auto static_array_type_info = (StaticArrayTypeInfo *)type_info;
+        return static_array_type_info->size * type_size(static_array_type_info->base_type);
+    }
+    case TypeInfoType::STRUCT:
+        return ((StructTypeInfo *)type_info)->size;
+    case TypeInfoType::VECTOR: {
+        auto vector_type_info = (VectorTypeInfo *)type_info;
+        return vector_type_info->lanes * type_size(vector_type_info->base_type);
+    }
+    case TypeInfoType::STRING:
+        return sizeof(std::string);
+    case TypeInfoType::ARENA:
+    case TypeInfoType::POOL:
+        // 2 pointers and a u64, see Liam::Arena and Liam::Pool
+        return sizeof(void *) * 2 + 8;
+    case TypeInfoType::DYNAMIC_ARRAY:
+        // T *pointer, i64 size, i64 capacity, Arena *arena
+        return sizeof(void *) * 2 + 16;
+    case TypeInfoType::HASH_MAP:
+        // i8 *control, Entry *entries, i64 capacity, i64 size, i64 growth_left
+        return sizeof(void *) * 2 + 24;
+    default:
+        return 0;
+    }
+
+    return 0;
+}
+
+u64 type_alignment(TypeInfo *type_info) {
+    switch (type_info->type) {
+    case TypeInfoType::NUMBER:
+    case TypeInfoType::BOOLEAN:
+    case TypeInfoType::POINTER:
+    case TypeInfoType::VECTOR:
+        return type_size(type_info);
+    case TypeInfoType::SLICE:
+    case TypeInfoType::ARENA:
+    case TypeInfoType::POOL:
+    case TypeInfoType::DYNAMIC_ARRAY:
+    case TypeInfoType::HASH_MAP:
+        return sizeof(void *);
+    case TypeInfoType::STATIC_ARRAY:
+        return type_alignment(((StaticArrayTypeInfo *)type_info)->base_type);
+    case TypeInfoType::STRUCT:
+        return ((StructTypeInfo *)type_info)->alignment;
+    case TypeInfoType::STRING:
+        return alignof(std::string);
+    default:
+        return 1;
+    }
+}
+
+u64 compute_struct_layout(StructTypeInfo *struct_type_info) {
+    // structs made by the compiler e.g. hash map entries have no statement and so no tags
+    StructStatement *statement   = struct_type_info->defined_location;
+    Tags             struct_tags = statement != NULL ? statement->tags : Tags{.flags = 0, .alignment = 0};
+
+    // members are placed in order each at the next offset that fits their
+    // alignment, then the end is padded to the alignment of the biggest one
+    // #packed takes a member down to an alignment of 1 and #align(n) raises it to
+    // at least n, which is what alignas and __attribute__((packed)) do in c++
+    u64 offset    = 0;
+    u64 alignment = 1;
+    for (u64 i = 0; i < struct_type_info->members.size(); i++) {
+        TypeInfo *member_type_info = std::get<1>(struct_type_info->members[i]);
+        Tags      member_tags      = statement != NULL ? statement->member_tags[i] : Tags{.flags = 0, .alignment = 0};
+
+        u64 member_alignment = std::max(type_alignment(member_type_info), (u64)1);
+        if (statement != NULL && is_packed_member(statement, i)) {
+            member_alignment = 1;
+        }
+        member_alignment = std::max(member_alignment, member_tags.alignment);
+
+        offset = (offset + member_alignment - 1) / member_alignment * member_alignment;
+        offset += type_size(member_type_info);
+        alignment = std::max(alignment, member_alignment);
+    }
+    u64 natural_alignment = alignment;
+    alignment             = std::max(alignment, struct_tags.alignment);
+
+    // empty structs still take up a byte in c++
+    struct_type_info->size      = std::max((offset + alignment - 1) / alignment * alignment, (u64)1);
+    struct_type_info->alignment = alignment;
+    return natural_alignment;
+}
@@ -1,5 +1,8 @@
 #pragma once
 #include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ast.h"
@@ -21,18 +24,73 @@ struct StaticArrayExpression;
 struct Expression;
 struct CompilationUnit;
 struct CompilationBundle;
+struct ErrorReporter;
+struct Tracer;
+
+// structs bigger than this many bytes are passed to fns as a const reference
+// when the fn never changes them, smaller ones are cheaper to copy in registers.
+// Dynamic arrays and hash maps always are as copying one copies all of its values
+#define PASS_BY_REFERENCE_THRESHOLD 32
+
+// how many generic fn instances deep one can be made before it is taken to be a
+// generic fn that makes a new instance of itself with a bigger type every call
+#define MAX_GENERIC_DEPTH 64
 
 struct TypeChecker {
     CompilationUnit   *compilation_unit;
     CompilationBundle *compilation_bundle;
+    ErrorReporter     *error_reporter;
+    Tracer            *tracer;
     std::list<Scope>   scopes;
 
-    TypeChecker();
+    // while checking the body of a for par, the number of scopes at the body so
+    // anything in a scope before it is shared between the threads, 0 when not in
+    // one. The loop depth is how many loops deep in the body we are
+    u64 parallel_scope_depth;
+    u64 parallel_loop_depth;
+
+    // the #noalias slice params of the fn being checked, these are emitted as a different
+    // type to a Slice so a pointer to one cannot be passed where a ^[]T is expected
+    std::vector<std::string> noalias_slice_params;
+
+    // embedded files are read only so they can only be sliced where nothing can write through
+    // the slice. The places that can make sure of that, lets, fn args, for and print, set the
+    // expression that is allowed to be one before checking it. The fn being checked is kept
+    // so a let naming a slice can be checked against its body
+    Expression  *read_only_slice_expression;
+    FnStatement *current_fn;
+
+    // each slice of an embedded file given a name by a let or a fn param, with the fn that
+    // cannot write through that name. Checked at the end once every fn body has been checked
+    std::vector<std::tuple<CompilationUnit *, Expression *, FnStatement *, std::string>> read_only_slices;
+
+    // every HashMap[K, V] seen, checked at the end so struct keys are fully typed
+    std::vector<std::tuple<CompilationUnit *, HashMapTypeExpression *>> hash_map_type_expressions;
+
+    // the values held by every [dyn]T, HashMap[K, V] and Pool[T], checked at the end for the same reason
+    std::vector<std::tuple<CompilationUnit *, TypeExpression *>> element_type_expressions;
+
+    // the types given to the generic fn instance being checked, these names are looked up
+    // before any other types. Depth is how many instances deep the current fn was made from
+    std::vector<std::tuple<std::string, TypeInfo *>> generic_bindings;
+    u64                                              generic_depth;
+
+    // every distinct type gets an id so the instances of a generic fn can be looked up by the
+    // ids of their types, each one is only made and checked once however many calls there are.
+    // Instance bodies are checked after all the other fns as checking one can make more
+    std::unordered_map<std::string, u64>                                 type_ids;
+    std::map<std::tuple<FnStatement *, std::vector<u64>>, FnStatement *> generic_instances;
+    std::vector<FnStatement *>                                           generic_instances_to_check;
+
+    TypeChecker(ErrorReporter *error_reporter);
 
     void      new_scope();
     void      delete_scope();
     void      add_to_scope(TokenIndex token_index, TypeInfo *type_info);
     TypeInfo *get_from_scope(TokenIndex token_index);
+    u64       get_scope_depth(TokenIndex token_index);
+    bool      is_shared_in_parallel_for(Expression *expression);
+    bool      is_noalias_slice_param(Expression *expression);
 
     void type_check(CompilationBundle *bundle);
 
@@ -44,6 +102,7 @@ struct TypeChecker {
     void type_check_fn_decl(FnStatement *statement);
     void type_check_fn_statement_full(FnStatement *statement);
     void type_check_struct_statement_full(StructStatement *statement);
+    void type_check_struct_tags(StructTypeInfo *struct_type_info, u64 natural_alignment);
 
     void type_check_statement(Statement *statement);
     void type_check_return_statement(ReturnStatement *statement);
@@ -68,6 +127,11 @@ struct TypeChecker {
     void type_check_unary_expression(UnaryExpression *expression);
     void type_check_call_expression(CallExpression *expression);
     void type_check_get_expression(GetExpression *expression);
+    void type_check_vector_type_member(GetExpression *expression, TypeTypeInfo *type_type_info);
+    void type_check_vector_member(GetExpression *expression, VectorTypeInfo *vector_type_info);
+    void type_check_allocator_member(GetExpression *expression, TypeInfo *allocator_type_info);
+    void type_check_dynamic_array_member(GetExpression *expression, DynamicArrayTypeInfo *dynamic_array_type_info);
+    void type_check_hash_map_member(GetExpression *expression, HashMapTypeInfo *hash_map_type_info);
     void type_check_group_expression(GroupExpression *expression);
     void type_check_null_literal_expression(NullLiteralExpression *expression);
     void type_check_zero_literal_expression(ZeroLiteralExpression *expression);
@@ -76,6 +140,8 @@ struct TypeChecker {
     void type_check_static_array_literal_expression(StaticArrayExpression *expression);
     void type_check_subscript_expression(SubscriptExpression *expression);
     void type_check_range_expression(RangeExpression *expression);
+    void type_check_arena_slice_expression(ArenaSliceExpression *expression);
+    void type_check_embed_expression(EmbedExpression *expression);
 
     void type_check_type_expression(TypeExpression *type_expression);
     void type_check_unary_type_expression(UnaryTypeExpression *type_expression);
@@ -83,7 +149,32 @@ struct TypeChecker {
     void type_check_get_type_expression(GetTypeExpression *type_expression);
     void type_check_static_array_type_expression(StaticArrayTypeExpression *type_expression);
     void type_check_slice_type_expression(SliceTypeExpression *type_expression);
+    void type_check_pool_type_expression(PoolTypeExpression *type_expression);
+    void type_check_dynamic_array_type_expression(DynamicArrayTypeExpression *type_expression);
+    void type_check_hash_map_type_expression(HashMapTypeExpression *type_expression);
+    void type_check_hash_map_keys();
+    void type_check_element_types();
+    void type_check_read_only_slices();
+    void type_check_copy(Expression *expression);
+
+    FnStatement *instantiate_generic_fn(FnStatement *generic_statement, CallExpression *expression,
+                                        std::vector<TypeInfo *> arg_type_infos);
+    bool         infer_generic_arguments(FnStatement *generic_statement, TypeExpression *param_type_expression,
+                                         TypeInfo *arg_type_info, std::vector<TypeInfo *> &generic_arguments);
+    void         type_check_generic_instances();
+    u64          type_id(TypeInfo *type_info);
+
+    TypeInfo *vector_mask_type(VectorTypeInfo *vector_type_info);
+    TypeInfo *type_check_allocator(Expression *allocator);
+    bool      mark_hash_key(TypeInfo *type_info);
 };
 
 bool                     type_match(TypeInfo *a, TypeInfo *b);
-std::vector<SortingNode> topilogical_sort(std::vector<StructStatement *> structs);
+std::vector<SortingNode> topilogical_sort(ErrorReporter *error_reporter, std::vector<StructStatement *> structs);
+
+// size and alignment of a type as it will be laid out by the c++ compiler, struct
+// layouts have to be computed first with compute_struct_layout, which gives the
+// alignment the struct would have without #align on it
+u64 type_size(TypeInfo *type_info);
+u64 type_alignment(TypeInfo *type_info);
+u64 compute_struct_layout(StructTypeInfo *struct_type_info);
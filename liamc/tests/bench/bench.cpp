@@ -0,0 +1,267 @@
+// Benchmarks each phase of the compiler on its own, inputs are loaded into
+// memory before anything is timed so disk access does not add noise. Each
+// phase is given a fresh copy of the output of the phases before it because
+// they all change the ast or the compilation units they are given.
+//   liamc_bench                       benchmark a generated program
+//   liamc_bench --scale 5000          make the generated program bigger
+//   liamc_bench a.liam b.liam         benchmark real files as one bundle
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define HAS_CYCLE_COUNTER
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_CYCLE_COUNTER
+#endif
+
+#include "cpp_backend.h"
+#include "cxxopts/cxxopts.h"
+#include "errors.h"
+#include "file.h"
+#include "lexer.h"
+#include "parser.h"
+#include "type_checker.h"
+
+struct Samples {
+    std::vector<u64> nanoseconds;
+    std::vector<u64> cycles;
+};
+
+struct Input {
+    std::vector<FileData *> files;
+    u64                     byte_count;
+    u64                     token_count;
+};
+
+u64 read_cycles() {
+#if defined(HAS_CYCLE_COUNTER)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+u64 read_nanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// lots of fns and structs using most of the language, roughly 100 lines per scale
+std::string generate_source(u64 scale) {
+    std::string source = "fn main() void {}\n\n";
+
+    for (u64 i = 0; i < scale; i++) {
+        source.append(std::format("struct Point{} {{\n", i));
+        source.append(std::format("    x: i64,\n    y: i64,\n    z: f64,\n    next: ^Point{}\n}}\n\n", i));
+        source.append(std::format("fn work_{}(a: i64, b: i64, p: ^Point{}) i64 {{\n", i, i));
+        source.append("    let array : [8]i64 = [8]i64{1, 2, 3, 4, 5, 6, 7, 8};\n");
+        source.append("    let total : i64 = 0;\n");
+        source.append("    for value : array {\n");
+        source.append("        total = total + value * a - b;\n");
+        source.append("    }\n");
+        source.append("    for i : {0:8} {\n");
+        source.append("        if i % 2 == 0 {\n");
+        source.append("            total = total + array[i];\n");
+        source.append("        }\n");
+        source.append("    }\n");
+        source.append("    let s := \"some string literal\";\n");
+        source.append("    let f : f64 = 1.5f64 * 2.25f64;\n");
+        source.append("    let flag : bool = a < b and b > 0 or false;\n");
+        source.append("    return total + p.x + p.y;\n");
+        source.append("}\n\n");
+    }
+
+    return source;
+}
+
+FileData *make_file_data(std::string path, std::string source) {
+    char *data = (char *)malloc(source.size());
+    memcpy(data, source.data(), source.size());
+
+    return new FileData{.absolute_path = std::filesystem::absolute(path),
+                        .data          = data,
+                        .data_length   = source.size(),
+                        .line_count    = (u64)std::count(source.begin(), source.end(), '\n') + 1};
+}
+
+std::vector<CompilationUnit *> lex(Input *input) {
+    std::vector<CompilationUnit *> compilation_units;
+    for (FileData *file_data : input->files) {
+        Lexer lexer = Lexer(file_data);
+        compilation_units.push_back(lexer.lex());
+    }
+
+    return compilation_units;
+}
+
+CompilationBundle *parse(std::vector<CompilationUnit *> compilation_units, ErrorReporter *error_reporter) {
+    for (CompilationUnit *compilation_unit : compilation_units) {
+        Parser parser = Parser(compilation_unit, error_reporter);
+        parser.parse();
+    }
+
+    return new CompilationBundle(compilation_units);
+}
+
+CompilationBundle *type_check(CompilationBundle *bundle, ErrorReporter *error_reporter) {
+    TypeChecker type_checker = TypeChecker(error_reporter);
+    type_checker.type_check(bundle);
+    return bundle;
+}
+
+// setup makes a new state for every run and is not timed, only run is. The ast
+// is leaked the same as in the compiler so keep the iterations reasonable
+template <typename Setup, typename Run> Samples bench(u64 warmup, u64 iterations, Setup setup, Run run) {
+    Samples samples;
+    for (u64 i = 0; i < warmup + iterations; i++) {
+        auto state = setup();
+
+        u64 start_ns     = read_nanoseconds();
+        u64 start_cycles = read_cycles();
+        run(state);
+        u64 end_cycles = read_cycles();
+        u64 end_ns     = read_nanoseconds();
+
+        if (i >= warmup) {
+            samples.nanoseconds.push_back(end_ns - start_ns);
+            samples.cycles.push_back(end_cycles - start_cycles);
+        }
+    }
+
+    return samples;
+}
+
+u64 percentile(std::vector<u64> values, f64 percent) {
+    std::sort(values.begin(), values.end());
+    u64 index = (u64)((f64)(values.size() - 1) * percent);
+    return values[index];
+}
+
+void print_samples(std::string name, Samples *samples, Input *input) {
+    u64 median_ns     = percentile(samples->nanoseconds, 0.5);
+    u64 p95_ns        = percentile(samples->nanoseconds, 0.95);
+    u64 median_cycles = percentile(samples->cycles, 0.5);
+
+    std::string line = std::format("{:<12} :: median {:>10.3f}ms :: p95 {:>10.3f}ms :: {:>8.1f}MB/s", name,
+                                   (f64)median_ns / 1e6, (f64)p95_ns / 1e6,
+                                   ((f64)input->byte_count / (1024.0 * 1024.0)) / ((f64)median_ns / 1e9));
+
+#if defined(HAS_CYCLE_COUNTER)
+    line.append(std::format(" :: {:>7.2f} cycles/byte :: {:>7.2f} cycles/token",
+                            (f64)median_cycles / (f64)input->byte_count,
+                            (f64)median_cycles / (f64)input->token_count));
+#else
+    line.append(std::format(" :: {:>7.2f} ns/byte :: {:>7.2f} ns/token", (f64)median_ns / (f64)input->byte_count,
+                            (f64)median_ns / (f64)input->token_count));
+#endif
+
+    std::cout << line << "\n";
+}
+
+void exit_on_errors(ErrorReporter *error_reporter, FileManager *file_manager) {
+    if (error_reporter->error_count() == 0) {
+        return;
+    }
+
+    for (auto &error : error_reporter->parse_errors) {
+        error.print_error_message(file_manager);
+    }
+
+    for (auto &error : error_reporter->type_check_errors) {
+        error.print_error_message(file_manager);
+    }
+
+    panic("Cannot benchmark input with errors");
+}
+
+i32 main(i32 argc, char **argv) {
+    cxxopts::Options options = cxxopts::Options("liamc_bench", "Benchmark each phase of the liam compiler");
+    options.add_options()("w,warmup", "Runs before timing starts", cxxopts::value<u64>()->default_value("3"));
+    options.add_options()("i,iterations", "Timed runs per phase", cxxopts::value<u64>()->default_value("20"));
+    options.add_options()("s,scale", "Size of the generated program", cxxopts::value<u64>()->default_value("1000"));
+    options.add_options()("h,help", "See this help screen", cxxopts::value<bool>()->default_value("false"));
+    options.add_options()("f,files", "Files to benchmark instead of the generated program",
+                          cxxopts::value<std::vector<std::string>>());
+    options.parse_positional({"files"});
+
+    cxxopts::ParseResult result = options.parse(argc, argv);
+    if (result.count("help")) {
+        std::cout << options.help() << std::endl;
+        return 0;
+    }
+
+    u64                      warmup     = result["warmup"].as<u64>();
+    u64                      iterations = result["iterations"].as<u64>();
+    std::vector<std::string> paths;
+    if (iterations == 0) {
+        panic("Need at least one iteration to benchmark");
+    }
+
+    if (result.count("files")) {
+        paths = result["files"].as<std::vector<std::string>>();
+    }
+
+    // files are loaded through the file manager so imports work the same as
+    // in the compiler, the error reporter is only used to check the input
+    FileManager   file_manager;
+    ErrorReporter error_reporter;
+    Input         input = Input{.files = {}, .byte_count = 0, .token_count = 0};
+
+    if (paths.empty()) {
+        input.files.push_back(make_file_data("bench.liam", generate_source(result["scale"].as<u64>())));
+    }
+
+    for (auto &path : paths) {
+        Option<FileData *> file_data = file_manager.load_relative_from_cwd(path);
+        if (!file_data.is_some()) {
+            panic(std::format("cannot find input file '{}'", path));
+        }
+
+        input.files.push_back(file_data.value());
+    }
+
+    for (FileData *file_data : input.files) {
+        input.byte_count += file_data->data_length;
+    }
+
+    // check the input compiles before timing anything
+    std::vector<CompilationUnit *> compilation_units = lex(&input);
+    for (CompilationUnit *compilation_unit : compilation_units) {
+        input.token_count += compilation_unit->token_buffer.size();
+    }
+
+    type_check(parse(compilation_units, &error_reporter), &error_reporter);
+    exit_on_errors(&error_reporter, &file_manager);
+
+    std::cout << std::format("{} files :: {} bytes :: {} tokens :: {} warmup :: {} iterations\n", input.files.size(),
+                             input.byte_count, input.token_count, warmup, iterations);
+
+    Samples lex_samples = bench(
+        warmup, iterations, [&]() { return &input; }, [](Input *input) { lex(input); });
+    print_samples("lex", &lex_samples, &input);
+
+    Samples parse_samples = bench(
+        warmup, iterations, [&]() { return lex(&input); },
+        [&](std::vector<CompilationUnit *> compilation_units) { parse(compilation_units, &error_reporter); });
+    print_samples("parse", &parse_samples, &input);
+
+    Samples type_check_samples = bench(
+        warmup, iterations, [&]() { return parse(lex(&input), &error_reporter); },
+        [&](CompilationBundle *bundle) { type_check(bundle, &error_reporter); });
+    print_samples("type check", &type_check_samples, &input);
+
+    Samples code_gen_samples = bench(
+        warmup, iterations, [&]() { return type_check(parse(lex(&input), &error_reporter), &error_reporter); },
+        [](CompilationBundle *bundle) { CppBackend().emit(bundle); });
+    print_samples("code gen", &code_gen_samples, &input);
+
+    return 0;
+}
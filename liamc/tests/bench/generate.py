@@ -0,0 +1,134 @@
+# Generates synthetic liam programs for benchmarking the compiler, each family
+# stresses a different part of it and takes a size so scaling can be measured.
+# Can be run on its own to look at what is made, e.g.
+#   python generate.py wide_structs 1000 out_dir
+import os
+import sys
+
+member_types = ["i64", "i32", "i16", "u8", "u16", "f32", "f64", "bool"]
+
+
+def main_fn(body=""):
+    return f"fn main() void {{\n{body}}}\n"
+
+
+def wide_structs(size):
+    source = ""
+    for i in range(size):
+        source += f"struct TypeStruct{i} {{\n"
+        members = [f"    m_{m}: {type}" for m, type in enumerate(member_types * 2)]
+        # pointers to the previous struct so there is something to sort
+        if i > 0:
+            members.append(f"    previous: ^TypeStruct{i - 1}")
+        source += ",\n".join(members) + "\n}\n\n"
+
+    return {"bench.liam": source + main_fn()}
+
+
+def many_fns(size):
+    # the old tests/output.py stress program, lots of fns full of lets
+    source = main_fn()
+    for i in range(size):
+        source += f"fn add_{i}(a: i64, b: i64, c: i64, d: bool, e: ^i64) void {{\n"
+        for x in range(10):
+            source += f"    let n_1_{x} := {x};\n"
+            source += f"    let s_1_{x} := \"{x}\";\n"
+            source += f"    let b_1_{x} := false;\n"
+            source += f"    let n_2_{x} : i64 = {x};\n"
+            source += f"    let b_2_{x} : bool = false;\n"
+            source += f"    let p_2_{x} : ^i64 = null;\n"
+        source += "}\n\n"
+
+    return {"bench.liam": source}
+
+
+def deep_nesting(size):
+    body = ""
+    for depth in range(size):
+        indent = "    " * (depth + 1)
+        if depth % 2 == 0:
+            body += f"{indent}if {depth} < {depth + 1} {{\n"
+        else:
+            body += f"{indent}while false {{\n"
+        body += f"{indent}    let v_{depth} : i64 = {depth};\n"
+
+    for depth in reversed(range(size)):
+        body += "    " * (depth + 1) + "}\n"
+
+    return {"bench.liam": main_fn(body)}
+
+
+def long_expressions(size):
+    terms = " + ".join(f"({i} * 3 - 1)" for i in range(size))
+    body = f"    let sum : i64 = {terms};\n"
+    body += f"    let is : bool = {' and '.join(f'{i} < {i + 1}' for i in range(size))};\n"
+    return {"bench.liam": main_fn(body)}
+
+
+def many_imports(size):
+    files = {}
+    source = ""
+    body = ""
+    for i in range(size):
+        files[f"lib_{i}.liam"] = f"fn get_{i}() i64 {{\n    return {i};\n}}\n"
+        source += f"import \"lib_{i}.liam\" lib_{i};\n"
+        body += f"    let v_{i} : i64 = lib_{i}.get_{i}();\n"
+
+    files["bench.liam"] = source + "\n" + main_fn(body)
+    return files
+
+
+def many_literals(size):
+    body = ""
+    for i in range(size):
+        body += f"    let n_{i} := {i}i64;\n"
+        body += f"    let f_{i} := {i}.5f64;\n"
+        body += f"    let s_{i} := \"literal {i}\";\n"
+        body += f"    let b_{i} := true;\n"
+
+    return {"bench.liam": main_fn(body)}
+
+
+def big_static_arrays(size):
+    body = ""
+    for a in range(4):
+        values = ", ".join(str(i) for i in range(size))
+        body += f"    let array_{a} : [{size}]i64 = [{size}]i64{{{values}}};\n"
+
+    return {"bench.liam": main_fn(body)}
+
+
+families = {
+    "wide_structs": (wide_structs, [100, 1000, 10000]),
+    "many_fns": (many_fns, [100, 1000, 10000]),
+    "deep_nesting": (deep_nesting, [10, 100, 500]),
+    "long_expressions": (long_expressions, [100, 1000, 5000]),
+    "many_imports": (many_imports, [10, 100, 500]),
+    "many_literals": (many_literals, [1000, 10000, 100000]),
+    "big_static_arrays": (big_static_arrays, [100, 1000, 10000]),
+}
+
+
+# writes the files of a family into dir and returns the paths, main first
+def write_family(name, size, dir):
+    os.makedirs(dir, exist_ok=True)
+    files = families[name][0](size)
+
+    paths = []
+    for file_name, source in files.items():
+        path = os.path.join(dir, file_name)
+        with open(path, "w") as f:
+            f.write(source)
+        paths.append(path)
+
+    paths.sort(key=lambda path: not path.endswith("bench.liam"))
+    return paths
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 4 or sys.argv[1] not in families:
+        print(f"usage: python generate.py <{'|'.join(families)}> <size> <out dir>")
+        sys.exit(1)
+
+    for path in write_family(sys.argv[1], int(sys.argv[2]), sys.argv[3]):
+        print(path)
@@ -0,0 +1,222 @@
+# Compiles every generated benchmark with liamc and checks the time of each phase
+# and the peak memory against the stored baselines, exits with 1 if anything got
+# slower or bigger by more than the allowed amount. Baselines are stored relative to
+# the reference benchmark run on the same machine so they hold on any machine.
+#   python runner.py                  run and check against baselines.json
+#   python runner.py --update         run and write the results as the new baselines
+#   python runner.py --family many_fns --compiler ../../build/debug/liamc
+import argparse
+import json
+import math
+import os
+import subprocess
+import sys
+import tempfile
+
+from generate import families, write_family
+
+bench_dir = os.path.dirname(os.path.abspath(__file__))
+baselines_path = os.path.join(bench_dir, "baselines.json")
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--compiler", default=os.path.join(bench_dir, "../../build/release/liamc"))
+parser.add_argument("--family", action="append", help="only run these families")
+parser.add_argument("--repeat", type=int, default=3, help="runs per benchmark, the fastest is kept")
+parser.add_argument("--tolerance", type=float, default=0.25, help="allowed slow down as a fraction of the baseline")
+parser.add_argument("--noise-ms", type=float, default=5.0, help="differences smaller than this are ignored")
+parser.add_argument("--update", action="store_true", help="write results to baselines.json")
+args = parser.parse_args()
+
+# every result is divided by the same phase of this one before it is stored or checked,
+# a faster or slower machine changes both by about the same amount so the ratio is kept.
+# A change that slows the reference as much as everything else is not seen by the ratios,
+# only what got slower compared to the rest of the compiler or scales worse is
+reference_family, reference_size = "many_fns", 1000
+
+
+# the phases are the top level spans in the trace, see Compiler::compile
+def phase_times_from_trace(trace_path):
+    events = json.load(open(trace_path))["traceEvents"]
+    begins = {}
+    times = {}
+    for event in events:
+        if event["cat"] != "phase":
+            continue
+
+        if event["ph"] == "B":
+            begins[event["name"]] = event["ts"]
+        elif event["ph"] == "E":
+            times[event["name"]] = (event["ts"] - begins[event["name"]]) / 1000.0
+
+    return times
+
+
+def peak_rss_from_mem_stats(output):
+    # Memory after code gen :: peak rss :: 4.3MB
+    units = {"B": 1, "KB": 1024, "MB": 1024 * 1024}
+    peak = 0
+    for line in output.splitlines():
+        if ":: peak rss ::" not in line:
+            continue
+
+        value = line.split("::")[-1].strip()
+        for unit in ["MB", "KB", "B"]:
+            if value.endswith(unit):
+                peak = max(peak, float(value[: -len(unit)]) * units[unit])
+                break
+
+    return int(peak)
+
+
+def run_benchmark(family, size, dir):
+    paths = write_family(family, size, dir)
+    trace_path = os.path.join(dir, "trace.json")
+
+    best = None
+    for _ in range(args.repeat):
+        output = subprocess.run([
+            args.compiler,
+            *paths,
+            "--out", os.path.join(dir, "out.cpp"),
+            "--trace", trace_path,
+            "--mem-stats",
+        ], capture_output=True)
+
+        if output.returncode != 0:
+            print(output.stdout.decode("UTF-8"))
+            print(output.stderr.decode("UTF-8"))
+            return None
+
+        result = phase_times_from_trace(trace_path)
+        result["peak rss"] = peak_rss_from_mem_stats(output.stdout.decode("UTF-8"))
+
+        if best is None:
+            best = result
+        else:
+            best = {key: min(best[key], value) for key, value in result.items()}
+
+    return best
+
+
+# how the time grows with the size, 1 is linear and 2 is quadratic, this does not
+# depend on the machine so it catches scaling problems even when the baselines are old
+def scaling_exponent(results, sizes):
+    small, large = sizes[0], sizes[-1]
+    small_time = sum(value for key, value in results[str(small)].items() if key != "peak rss")
+    large_time = sum(value for key, value in results[str(large)].items() if key != "peak rss")
+    if small_time <= 0 or large_time <= 0:
+        return None
+
+    return math.log(large_time / small_time) / math.log(large / small)
+
+
+def is_regression(baseline, value, noise):
+    return value > baseline * (1 + args.tolerance) and value - baseline > noise
+
+
+def relative_to_reference(result, reference):
+    return {key: value / reference[key] for key, value in result.items() if reference.get(key, 0) > 0}
+
+
+# the baseline is what the result would be on this machine, it is checked in ms and
+# bytes so the noise allowance still means the same thing
+def find_regressions(family, size, result, reference, baseline):
+    found = []
+    for key, value in result.items():
+        if key not in baseline or key not in reference:
+            continue
+
+        expected = baseline[key] * reference[key]
+        noise = 1024 * 1024 if key == "peak rss" else args.noise_ms
+        if is_regression(expected, value, noise):
+            found.append(f"{family} {size} {key} went from {expected:.2f} to {value:.2f}")
+
+    return found
+
+
+def fastest(a, b):
+    return {key: min(value, b[key]) for key, value in a.items() if key in b}
+
+
+baselines = {}
+if os.path.exists(baselines_path):
+    baselines = json.load(open(baselines_path))
+
+# baselines against a different reference cannot be compared, --update replaces them
+if baselines.get("reference") != f"{reference_family} {reference_size}":
+    baselines = {}
+
+results = {}
+times = {}
+regressions = []
+
+for family, (_, sizes) in families.items():
+    if args.family and family not in args.family:
+        continue
+
+    # run again before each family so it keeps up with the machine getting busier or quieter
+    with tempfile.TemporaryDirectory() as dir:
+        reference = run_benchmark(reference_family, reference_size, dir)
+
+    if reference is None:
+        print(f"BENCH FAILED ]: {reference_family} {reference_size} liamc compile error")
+        sys.exit(1)
+
+    results[family] = {}
+    times[family] = {}
+    for size in sizes:
+        with tempfile.TemporaryDirectory() as dir:
+            result = run_benchmark(family, size, dir)
+
+        if result is None:
+            print(f"BENCH FAILED ]: {family} {size} liamc compile error")
+            regressions.append(f"{family} {size} failed to compile")
+            continue
+
+        times[family][str(size)] = result
+        results[family][str(size)] = relative_to_reference(result, reference)
+        print(f"{family:<20} {size:>7} :: " +
+              " :: ".join(f"{key} {value:.2f}ms" for key, value in result.items() if key != "peak rss") +
+              f" :: peak rss {result['peak rss'] / (1024 * 1024):.1f}MB")
+
+        baseline = baselines.get(family, {}).get(str(size))
+        if baseline is None:
+            continue
+
+        # a busy machine can slow down a single run a lot, so anything that looks slower is run
+        # again with the reference and only counted if the fastest of both runs is still slower
+        checked_result, checked_reference = result, reference
+        if len(find_regressions(family, size, result, reference, baseline)) > 0:
+            with tempfile.TemporaryDirectory() as dir:
+                rerun_reference = run_benchmark(reference_family, reference_size, dir)
+                rerun = run_benchmark(family, size, dir)
+
+            if rerun_reference is not None and rerun is not None:
+                checked_result = fastest(result, rerun)
+                checked_reference = fastest(reference, rerun_reference)
+
+        regressions.extend(find_regressions(family, size, checked_result, checked_reference, baseline))
+
+    if len(results[family]) == len(sizes):
+        exponent = scaling_exponent(times[family], sizes)
+        results[family]["scaling"] = exponent
+        baseline_exponent = baselines.get(family, {}).get("scaling")
+        if exponent is not None and baseline_exponent is not None and exponent > baseline_exponent + 0.3:
+            regressions.append(f"{family} scaling went from n^{baseline_exponent:.2f} to n^{exponent:.2f}")
+
+if args.update:
+    baselines["reference"] = f"{reference_family} {reference_size}"
+    baselines.update(results)
+    with open(baselines_path, "w") as f:
+        json.dump(baselines, f, indent=4)
+        f.write("\n")
+    print(f"\nWrote baselines to {baselines_path}")
+    sys.exit(0)
+
+if len(regressions) > 0:
+    print("\nRegressions ::")
+    for regression in regressions:
+        print(f"    {regression}")
+    sys.exit(1)
+
+print("\nNo regressions")
@@ -5,23 +5,38 @@ import subprocess
 import os
 
 source_dir = os.path.dirname(__file__) + "/liam/"
+errors_dir = source_dir + "errors/"
 compiler_path = os.path.dirname(__file__) + "/../build/debug/liamc"
 stdlib_path = os.path.dirname(__file__) + "/../stdlib"
 core_path = os.path.dirname(__file__) + "/../core"
 
+# every test is ran in each profile, they should print the same thing
+profiles = ["debug", "release"]
+
 source_files = []
 
 for f in listdir(source_dir):
     if isfile(join(source_dir, f)) and f.endswith(".liam"):
-        source_files.append(join(source_dir, f))
+        source_files.append([join(source_dir, f)])
 
+# a directory is one test made of all the files in it, the file named after the
+# directory has the expected lines and is passed after the others e.g.
+# generics_across_files/pick.liam generics_across_files/generics_across_files.liam
+for d in listdir(source_dir):
+    main_file = join(source_dir, d, d + ".liam")
+    if isdir(join(source_dir, d)) and isfile(main_file):
+        other_files = sorted(join(source_dir, d, f) for f in listdir(join(source_dir, d)) if f.endswith(".liam"))
+        source_files.append([f for f in other_files if f != main_file] + [main_file])
 
-failed_tests_count = 0
-tests_count = len(source_files)
+# programs liamc has to reject, their expected lines are parts of the errors it reports
+error_files = []
 
-for i, file_path in enumerate(source_files):
-    file_name_for_output = os.path.basename(file_path)
+for f in listdir(errors_dir):
+    if isfile(join(errors_dir, f)) and f.endswith(".liam"):
+        error_files.append(join(errors_dir, f))
 
+
+def expected_lines(file_path):
     lines = []
     source = open(file_path).readlines()
     for line in source:
@@ -29,47 +44,94 @@ for i, file_path in enumerate(source_files):
             lines.append(line.strip("\n/"))
         else:
             break  
+    return lines
+
+
+# a test whose last expected line is a PANIC has to stop with that panic, e.g.
+# "//PANIC :: index 1 is out of bounds for size 1", the file and line are not
+# compared. Only debug checks subscripts so these only run in debug
+def expects_panic(lines):
+    return len(lines) > 0 and lines[-1].startswith("PANIC")
+
+
+tests = []
+for files in source_files:
+    for p in profiles:
+        if p == "debug" or not expects_panic(expected_lines(files[-1])):
+            tests.append((files, p))
+
+for f in error_files:
+    tests.append(([f], None))
+
+failed_tests_count = 0
+tests_count = len(tests)
+
+for i, (file_paths, profile) in enumerate(tests):
+    file_name_for_output = os.path.basename(file_paths[-1])
+
+    lines = expected_lines(file_paths[-1])
+
+    if profile is None:
+        compile_output = subprocess.run([compiler_path, *file_paths], capture_output=True)
+        errors = compile_output.stderr.decode("UTF-8")
+        missing = [line for line in lines if line not in errors]
+        if compile_output.returncode == 0 or len(missing) > 0:
+            print(f"({i + 1},{tests_count}) TEST FAILED ]: {file_name_for_output} (error) expected {missing} in {errors}")
+            failed_tests_count += 1
+        else:
+            print(f"({i + 1},{tests_count}) TEST PASSED [:")
+        continue
 
     compile_output = subprocess.run([
         compiler_path,
-        file_path,
+        *file_paths,
+        f"--profile={profile}",
     ], capture_output=True)
 
     if compile_output.stderr != b'' or compile_output.returncode != 0:
-        print(f"({i + 1},{len(source_files)}) TEST FAILED ]: {file_name_for_output} liamc compile error")
+        print(f"({i + 1},{tests_count}) TEST FAILED ]: {file_name_for_output} ({profile}) liamc compile error")
         failed_tests_count += 1
 
         print(compile_output.stderr.decode("UTF-8"))
 
         continue
 
+    # liamc puts the flags the profile wants on the first line of the output
+    # e.g. "// liamc profile debug, compile with: -O0 -g -pthread"
+    cxx_flags = open("out.cpp").readline().split("compile with:")[1].split()
+
     clang_output = subprocess.run([
         "clang++",
         "-I", f"{stdlib_path}/include",
         "-I", core_path,
         "-std=c++17",
+        *cxx_flags,
         "-o", "out.exe",
         "out.cpp"
     ], capture_output=True)
 
     if clang_output.returncode != 0:
-        print(f"({i + 1},{len(source_files)}) TEST FAILED ]: {file_name_for_output} clang++ compile error")
+        print(f"({i + 1},{tests_count}) TEST FAILED ]: {file_name_for_output} ({profile}) clang++ compile error")
         failed_tests_count += 1
         continue
 
     running_output = subprocess.run(["./out.exe"], capture_output=True)
 
-    if running_output.stderr != b'' or running_output.returncode != 0:
-        print(f"({i + 1},{len(source_files)}) TEST FAILED ]: runtime error")
+    panics = expects_panic(lines)
+    if running_output.stderr != b'' or (running_output.returncode != 0) != panics:
+        print(f"({i + 1},{tests_count}) TEST FAILED ]: {file_name_for_output} ({profile}) runtime error")
         failed_tests_count += 1
         continue
 
     output_lines = running_output.stdout.decode("UTF-8").splitlines()
+    if panics and len(output_lines) > 0 and output_lines[-1].startswith("PANIC") and \
+            output_lines[-1].endswith(lines[-1][len("PANIC"):]):
+        output_lines[-1] = lines[-1]
     if lines != output_lines:
-        print(f"({i + 1},{len(source_files)}) TEST FAILED ]: {file_name_for_output  } expected {lines} got {output_lines}")
+        print(f"({i + 1},{tests_count}) TEST FAILED ]: {file_name_for_output} ({profile}) expected {lines} got {output_lines}")
         failed_tests_count += 1
     else:
-        print(f"({i + 1},{len(source_files)}) TEST PASSED [:")
+        print(f"({i + 1},{tests_count}) TEST PASSED [:")
 
     if os.path.exists("out.exe"):
         os.remove("out.exe")